@@ -6,7 +6,7 @@
 #ifndef FREERTOS_ACTIVE_HPP
 #define FREERTOS_ACTIVE_HPP
 
-#include "jungles_os_helpers/freertos/queue.hpp"
+#include "jungles_os_helpers/freertos/single_consumer_queue.hpp"
 #include "jungles_os_helpers/freertos/thread.hpp"
 #include "jungles_os_helpers/generic/active.hpp"
 
@@ -23,7 +23,7 @@ class active
     using Thread = jungles::freertos::thread;
 
     template<typename T>
-    using MessagePumpTemplate = jungles::freertos::queue<T, MessagePumpSize>;
+    using MessagePumpTemplate = jungles::freertos::single_consumer_queue<T, MessagePumpSize>;
 
     using Active = jungles::generic::active<Message, MessagePumpTemplate, Thread>;
     using MessagePump = typename Active::MessagePump;
@@ -39,9 +39,10 @@ class active
     {
     }
 
-    void send(Message&& m)
+    //! @return false when the mailbox is full, in the exception-free mode; otherwise an exception is thrown.
+    bool send(Message&& m)
     {
-        the_active.send(std::move(m));
+        return the_active.send(std::move(m));
     }
 
   private:
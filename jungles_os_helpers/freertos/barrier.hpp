@@ -0,0 +1,55 @@
+/**
+ * @file        barrier.hpp
+ * @brief       Rendezvous barrier of the tasks, identified with enumerations, on top of a FreeRTOS event group.
+ */
+#ifndef FREERTOS_BARRIER_HPP
+#define FREERTOS_BARRIER_HPP
+
+#include <chrono>
+
+#include "jungles_os_helpers/freertos/event_group.hpp"
+#include "jungles_os_helpers/utils/enum_to_bits.hpp"
+
+namespace jungles::freertos
+{
+
+/**
+ * @brief Each of the participants sets its own bit and blocks until all the participants have arrived.
+ *
+ * Arriving is a single xEventGroupSync() call, which also clears the bits once all of them are set, so the barrier
+ * is reused for the next cycle right away.
+ */
+template<auto... Participants>
+class barrier
+{
+  private:
+    using EnumToBits = utils::EnumToBits<Bits, Participants...>;
+
+  public:
+    static_assert(sizeof...(Participants) <= detail::max_event_bits(),
+                  "Too many participants for the underlying event group");
+
+    template<auto Participant>
+    void arrive_and_wait()
+    {
+        constexpr auto bit{EnumToBits::template to_bits<Participant>()};
+        event_group.sync(bit, all_bits);
+    }
+
+    //! @return false on timeout, in which case the participant remains arrived in the current cycle.
+    template<auto Participant>
+    bool arrive_and_wait(std::chrono::milliseconds timeout)
+    {
+        constexpr auto bit{EnumToBits::template to_bits<Participant>()};
+        return event_group.sync(bit, all_bits, timeout);
+    }
+
+  private:
+    static inline constexpr auto all_bits{EnumToBits::template to_bits<Participants...>()};
+
+    impl::event_group event_group;
+};
+
+} // namespace jungles::freertos
+
+#endif /* FREERTOS_BARRIER_HPP */
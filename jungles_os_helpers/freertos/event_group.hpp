@@ -6,10 +6,26 @@
 #define EVENT_GROUP_HPP
 
 #include "jungles_os_helpers/utils/enum_to_bits.hpp"
+#include "jungles_os_helpers/utils/event_set.hpp"
 
+#include <bit>
 #include <chrono>
-#include <memory>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
+#include <type_traits>
+
+// FreeRTOS.h defines these before it includes FreeRTOSConfig.h; they are repeated here, with the same values, because
+// only FreeRTOSConfig.h is included.
+#ifndef TICK_TYPE_WIDTH_16_BITS
+#define TICK_TYPE_WIDTH_16_BITS 0
+#endif
+#ifndef TICK_TYPE_WIDTH_32_BITS
+#define TICK_TYPE_WIDTH_32_BITS 1
+#endif
+#ifndef TICK_TYPE_WIDTH_64_BITS
+#define TICK_TYPE_WIDTH_64_BITS 2
+#endif
 
 // Unfortunately, we need to include FreeRTOSConfig.h here to statically assert on maximum number of event bits.
 // TODO: Find a way to avoid this, because it makes the PIMPL pattern ineffective.
@@ -18,26 +34,87 @@
 namespace jungles::freertos
 {
 
-using Bits = unsigned;
+namespace detail
+{
+
+static inline constexpr bool is_tick_type_64_bit()
+{
+#ifdef configTICK_TYPE_WIDTH_IN_BITS
+    return configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_64_BITS;
+#else
+    return false;
+#endif
+}
+
+}; // namespace detail
+
+//! EventBits_t has the width of the tick type, so it is 64-bit wide on the ports with 64-bit ticks.
+using Bits = std::conditional_t<detail::is_tick_type_64_bit(), std::uint64_t, unsigned>;
 
 namespace impl
 {
 
-struct event_group_impl;
+/**
+ * @brief Mirrors the layout of StaticEventGroup_t with the standard types, to reserve the storage for it without
+ * including the FreeRTOS headers.
+ *
+ * event_group.cpp statically asserts that StaticEventGroup_t fits in it, so a FreeRTOS configuration which makes it
+ * bigger, e.g. with configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES, is caught at compile time.
+ */
+struct event_group_storage_layout
+{
+    Bits event_bits;
+    std::size_t number_of_waiting_tasks;
+    void* list_index;
+    Bits list_end_value;
+    void* list_end_next;
+    void* list_end_previous;
+    std::size_t event_group_number;
+    std::uint8_t statically_allocated;
+};
 
+//! Allocation-free: the FreeRTOS event group is created with xEventGroupCreateStatic() on the inline storage.
 struct event_group
 {
     event_group();
     ~event_group();
 
+    event_group(const event_group&) = delete;
+    event_group& operator=(const event_group&) = delete;
+    event_group(event_group&&) = delete;
+    event_group& operator=(event_group&&) = delete;
+
     void set(Bits);
+
+    //! Defers setting the bits to the timer daemon task. Returns false when the timer command queue is full.
+    bool set_from_isr(Bits);
+
     Bits get();
-    Bits wait_one(Bits);
-    Bits wait_one(Bits, std::chrono::milliseconds);
+
+    //! Picks the single bit to take out of the set awaited bits, which are never 0.
+    using select_function = Bits (*)(Bits set, void* context);
+
+    //! Returns the set bit picked by the select function, which is cleared by this call, or 0 on timeout.
+    Bits wait_one(Bits, select_function, void* context);
+    Bits wait_one(Bits, std::chrono::milliseconds, select_function, void* context);
+
+    //! Returns all the set bits, which are cleared atomically on exit from the wait, or 0 on timeout.
+    Bits wait_any(Bits);
+    Bits wait_any(Bits, std::chrono::milliseconds);
+
+    //! Returns false on timeout, in which case none of the bits is cleared.
+    bool wait_all(Bits);
+    bool wait_all(Bits, std::chrono::milliseconds);
+
     void clear(Bits);
 
+    //! Sets the bits and waits until all the awaited bits are set, in one atomic operation; the awaited bits are
+    //! cleared on success. Returns false on timeout, in which case the set bits are left set.
+    bool sync(Bits set, Bits wait_for);
+    bool sync(Bits set, Bits wait_for, std::chrono::milliseconds);
+
   private:
-    std::unique_ptr<event_group_impl> pimpl;
+    alignas(event_group_storage_layout) std::byte storage[sizeof(event_group_storage_layout)];
 };
 
 }; // namespace impl
@@ -45,14 +122,28 @@ struct event_group
 namespace detail
 {
 
-static inline constexpr unsigned bit_position(unsigned val)
+static inline constexpr unsigned bit_position(Bits val)
 {
     // Assume 'val' is always positive and power of two
-    unsigned position{0};
-    while ((val & (1 << position)) == 0)
-        position++;
+    return std::countr_zero(val);
+}
 
-    return position;
+static inline constexpr Bits lowest_set_bit(Bits bits)
+{
+    return bits & -bits;
+}
+
+template<auto Event, auto... Events>
+static inline constexpr bool is_one_of{((Event == Events) or ...)};
+
+//! Lets the selection policy check the events of the group, when the policy defines check_events().
+template<typename Selection, auto... Events>
+static inline constexpr bool check_selection_events()
+{
+    if constexpr (requires { Selection::template check_events<Events...>(); })
+        return Selection::template check_events<Events...>();
+    else
+        return true;
 }
 
 static inline constexpr unsigned max_event_bits()
@@ -73,8 +164,7 @@ static inline constexpr unsigned max_event_bits()
     else if constexpr (configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_32_BITS)
         return 24;
     else if constexpr (configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_64_BITS)
-        // TODO: Support max 56 events bits for 64-bit tick type (requires different UnderlyingType).
-        return 32;
+        return 56;
     else // Never reached
         return 0;
 #endif
@@ -84,16 +174,92 @@ static inline constexpr unsigned max_event_bits()
 
 }; // namespace detail
 
-//! Many-to-one event group - might have multiple producers, but only one consumer.
-template<auto... Events>
-struct event_group
+/**
+ * @brief Policies which pick the event received by wait_one(), when more than one of the awaited events is set.
+ *
+ * select() may be called more than once per wait_one(), since another consumer can take the picked event first, so
+ * it must not change the state of the policy. A policy with state defines on_taken(), which is called with the event
+ * once wait_one() has taken it.
+ */
+namespace selection
+{
+
+//! The event with the lowest value. Cheapest, but the events with higher values starve when the lower ones keep
+//! firing.
+struct lowest_first
+{
+    Bits select(Bits set) const
+    {
+        return detail::lowest_set_bit(set);
+    }
+};
+
+/**
+ * @brief The event with the lowest value after the one served previously, wrapping around, so no event starves.
+ *
+ * The previously served event is kept in the group without any locking, so only a single task may call wait_one().
+ */
+struct round_robin
+{
+    Bits select(Bits set) const
+    {
+        auto not_served_yet{set & ~((Bits{1} << next_position) - 1)};
+        return detail::lowest_set_bit(not_served_yet != 0 ? not_served_yet : set);
+    }
+
+    void on_taken(Bits bit)
+    {
+        next_position = (detail::bit_position(bit) + 1) % (sizeof(Bits) * 8);
+    }
+
+  private:
+    unsigned next_position{0};
+};
+
+//! The events in the order of the list, from the highest priority; the unlisted events go after, lowest first.
+template<auto... Order>
+struct by_priority
+{
+    Bits select(Bits set) const
+    {
+        for (auto bit : order)
+            if ((set & bit) != 0)
+                return bit;
+        return detail::lowest_set_bit(set);
+    }
+
+    //! Called by basic_event_group, since the policy alone doesn't know the events of the group.
+    template<auto... Events>
+    static constexpr bool check_events()
+    {
+        static_assert((detail::is_one_of<Order, Events...> and ...),
+                      "Each event of the priority order must be an event of the group");
+        return true;
+    }
+
+  private:
+    static inline constexpr Bits order[]{(Bits{1} << static_cast<unsigned>(Order))...};
+};
+
+}; // namespace selection
+
+/**
+ * @brief Many-to-one event group - might have multiple producers, but only one consumer.
+ *
+ * \tparam Selection Policy picking the event received by wait_one(); see the jungles::freertos::selection namespace.
+ */
+template<typename Selection, auto... Events>
+struct basic_event_group
 {
   private:
     using EnumToBits = utils::EnumToBits<Bits, Events...>;
     using EnumType = typename EnumToBits::value_type;
 
   public:
+    using EventSet = utils::event_set<EnumType, Bits>;
+
     static_assert(sizeof...(Events) <= detail::max_event_bits(), "Too many events for the underlying event group");
+    static_assert(detail::check_selection_events<Selection, Events...>());
 
     template<auto... Evts>
     void set()
@@ -102,17 +268,35 @@ struct event_group
         pimpl.set(bits);
     }
 
+    /**
+     * @brief Sets the events from an interrupt.
+     *
+     * FreeRTOS doesn't set the bits in the interrupt, but defers it to the timer daemon task, which requires
+     * configUSE_TIMERS, INCLUDE_xTimerPendFunctionCall and INCLUDE_xEventGroupSetBitsFromISR. To wake up a single
+     * waiter without the daemon hop, use single_waiter_event_group.
+     *
+     * @return false when the timer command queue is full, so the events are not set.
+     */
+    template<auto... Evts>
+    bool set_from_isr()
+    {
+        constexpr auto bits{enum_to_bits.template to_bits<Evts...>()};
+        return pimpl.set_from_isr(bits);
+    }
+
     Bits get()
     {
         return pimpl.get();
     }
 
+    //! Waits for any of the events and clears the received one. When another consumer takes the event first, the
+    //! wait continues.
     template<auto... Evts>
     EnumType wait_one()
     {
         constexpr auto bits{enum_to_bits.template to_bits<Evts...>()};
-        auto event_bit{pimpl.wait_one(bits)};
-        pimpl.clear(event_bit);
+        auto event_bit{pimpl.wait_one(bits, select, &selection)};
+        on_taken(event_bit);
         return static_cast<EnumType>(detail::bit_position(event_bit));
     }
 
@@ -120,15 +304,46 @@ struct event_group
     std::optional<EnumType> wait_one(std::chrono::milliseconds timeout)
     {
         constexpr auto bits{enum_to_bits.template to_bits<Evts...>()};
-        auto event_bit{pimpl.wait_one(bits, timeout)};
+        auto event_bit{pimpl.wait_one(bits, timeout, select, &selection)};
         if (event_bit != 0)
         {
-            pimpl.clear(event_bit);
+            on_taken(event_bit);
             return static_cast<EnumType>(detail::bit_position(event_bit));
-        } else
-        {
-            return std::nullopt;
         }
+        else
+            return std::nullopt;
+    }
+
+    //! Waits for any of the events and returns all the awaited events which are set, clearing them atomically.
+    template<auto... Evts>
+    EventSet wait_any()
+    {
+        constexpr auto bits{enum_to_bits.template to_bits<Evts...>()};
+        return EventSet{pimpl.wait_any(bits)};
+    }
+
+    //! Returns an empty set on timeout.
+    template<auto... Evts>
+    EventSet wait_any(std::chrono::milliseconds timeout)
+    {
+        constexpr auto bits{enum_to_bits.template to_bits<Evts...>()};
+        return EventSet{pimpl.wait_any(bits, timeout)};
+    }
+
+    //! Waits until all the events are set and clears them atomically.
+    template<auto... Evts>
+    void wait_all()
+    {
+        constexpr auto bits{enum_to_bits.template to_bits<Evts...>()};
+        pimpl.wait_all(bits);
+    }
+
+    //! @return false on timeout, in which case none of the events is cleared.
+    template<auto... Evts>
+    bool wait_all(std::chrono::milliseconds timeout)
+    {
+        constexpr auto bits{enum_to_bits.template to_bits<Evts...>()};
+        return pimpl.wait_all(bits, timeout);
     }
 
     template<auto... Evts>
@@ -139,10 +354,25 @@ struct event_group
     }
 
   private:
+    static Bits select(Bits set, void* selection)
+    {
+        return static_cast<const Selection*>(selection)->select(set);
+    }
+
+    void on_taken(Bits event_bit)
+    {
+        if constexpr (requires { selection.on_taken(event_bit); })
+            selection.on_taken(event_bit);
+    }
+
     utils::EnumToBits<Bits, Events...> enum_to_bits;
     impl::event_group pimpl;
+    Selection selection;
 };
 
+template<auto... Events>
+using event_group = basic_event_group<selection::lowest_first, Events...>;
+
 }; // namespace jungles::freertos
 
 #endif /* EVENT_GROUP_HPP */
@@ -11,6 +11,7 @@
 #include "FreeRTOS.h"
 #include "event_groups.h"
 #include "projdefs.h"
+#include "task.h"
 
 namespace jungles
 {
@@ -18,14 +19,16 @@ namespace jungles
 namespace freertos
 {
 
-class flag
+//! \tparam AutoReset When true, a successful wait clears the flag, so each set() releases a single waiter.
+template<bool AutoReset = false>
+class basic_flag
 {
   public:
-    flag() : event_group_handle{xEventGroupCreate()}
+    basic_flag() : event_group_handle{xEventGroupCreate()}
     {
     }
 
-    ~flag()
+    ~basic_flag()
     {
         vEventGroupDelete(event_group_handle);
     }
@@ -35,6 +38,16 @@ class flag
         xEventGroupSetBits(event_group_handle, event_bit);
     }
 
+    //! Deferred to the timer daemon task, like xEventGroupSetBitsFromISR(). Returns false when the timer command queue
+    //! is full, so the flag is not set.
+    bool set_from_isr()
+    {
+        BaseType_t higher_priority_task_woken{pdFALSE};
+        auto result{xEventGroupSetBitsFromISR(event_group_handle, event_bit, &higher_priority_task_woken)};
+        portYIELD_FROM_ISR(higher_priority_task_woken);
+        return result == pdPASS;
+    }
+
     void reset()
     {
         xEventGroupClearBits(event_group_handle, event_bit);
@@ -42,26 +55,14 @@ class flag
 
     void wait()
     {
-        auto do_not_clear_on_exit{pdFALSE};
-        // Doesn't matter since we are waiting for a single bit.
-        auto wait_for_all_bits{pdTRUE};
-        auto wait_undefinitely{portMAX_DELAY};
-
-        xEventGroupWaitBits(event_group_handle, event_bit, do_not_clear_on_exit, wait_for_all_bits, wait_undefinitely);
+        wait_impl(portMAX_DELAY);
     }
 
     template<class Rep, class Period>
     bool wait_for(const std::chrono::duration<Rep, Period>& duration)
     {
         auto milliseconds{std::chrono::duration_cast<std::chrono::milliseconds>(duration).count()};
-
-        auto do_not_clear_on_exit{pdFALSE};
-        // Doesn't matter since we are waiting for a single bit.
-        auto wait_for_all_bits{pdTRUE};
-
-        auto r{xEventGroupWaitBits(
-            event_group_handle, event_bit, do_not_clear_on_exit, wait_for_all_bits, pdMS_TO_TICKS(milliseconds))};
-        return r != 0;
+        return wait_impl(pdMS_TO_TICKS(milliseconds));
     }
 
     bool is_set() const
@@ -71,10 +72,41 @@ class flag
     }
 
   private:
+    bool wait_impl(TickType_t delay)
+    {
+        // Doesn't matter since we are waiting for a single bit.
+        auto wait_for_all_bits{pdTRUE};
+        auto do_not_clear_on_exit{pdFALSE};
+
+        if constexpr (!AutoReset)
+            return xEventGroupWaitBits(
+                       event_group_handle, event_bit, do_not_clear_on_exit, wait_for_all_bits, delay) != 0;
+
+        // FreeRTOS unblocks all the waiters of the bit before clearing it on exit, so the bit is claimed afterwards.
+        // The value before the clear tells whether this waiter is the one which consumed the set; otherwise, another
+        // waiter was faster, so continue waiting.
+        TimeOut_t timeout;
+        vTaskSetTimeOutState(&timeout);
+        while (true)
+        {
+            if (xEventGroupWaitBits(event_group_handle, event_bit, do_not_clear_on_exit, wait_for_all_bits, delay) == 0)
+                return false;
+
+            if ((xEventGroupClearBits(event_group_handle, event_bit) & event_bit) != 0)
+                return true;
+
+            if (delay != portMAX_DELAY and xTaskCheckForTimeOut(&timeout, &delay) == pdTRUE)
+                return false;
+        }
+    }
+
     EventGroupHandle_t event_group_handle;
     static constexpr EventBits_t event_bit{0x01};
 };
 
+using flag = basic_flag<>;
+using auto_reset_flag = basic_flag<true>;
+
 } // namespace freertos
 } // namespace jungles
 
@@ -0,0 +1,160 @@
+/**
+ * @file	isr_to_task_queue.hpp
+ * @brief	Lock-free queue passing elements from an ISR to a task, for FreeRTOS.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef FREERTOS_ISR_TO_TASK_QUEUE_HPP
+#define FREERTOS_ISR_TO_TASK_QUEUE_HPP
+
+#include "FreeRTOS.h"
+#include "projdefs.h"
+#include "task.h"
+
+#include <atomic>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+
+#include "jungles_os_helpers/utils/uninitialized_array.hpp"
+
+namespace jungles
+{
+
+namespace freertos
+{
+
+/**
+ * @brief Single-producer, single-consumer ring, where the producer is an ISR and the consumer is a task.
+ *
+ * Unlike jungles::freertos::queue::send_from_isr(), which drops the element when a task holds the queue mutex, the
+ * ISR never waits for, nor loses to, the consumer: the ring is synchronized with two atomic indices only. The ISR
+ * notifies the consumer task directly, when the ring becomes non-empty, so send_from_isr() runs in bounded time.
+ * An element is rejected only when the ring is full.
+ *
+ * Only one ISR (or ISRs which can't preempt each other) may send, and only one task may receive. The receiving task
+ * shall not use the notification value (index 0) of its own for any other purpose.
+ *
+ * \tparam Size Capacity of the ring; must be a power of two.
+ */
+template<typename ElementType, std::size_t Size>
+class isr_to_task_queue
+{
+  public:
+    static_assert(Size > 1 and (Size & (Size - 1)) == 0, "Size must be a power of two");
+
+    isr_to_task_queue() = default;
+    isr_to_task_queue(const isr_to_task_queue&) = delete;
+    isr_to_task_queue& operator=(const isr_to_task_queue&) = delete;
+    isr_to_task_queue(isr_to_task_queue&&) = delete;
+    isr_to_task_queue& operator=(isr_to_task_queue&&) = delete;
+
+    ~isr_to_task_queue()
+    {
+        for (auto t{tail.load()}; t != head.load(); ++t)
+            ring.destroy(t % Size);
+    }
+
+    /**
+     * @brief Call from ISR context only.
+     * @return false, when the ring is full; the element is not moved then.
+     */
+    bool send_from_isr(ElementType&& elem)
+    {
+        auto h{head.load(std::memory_order_relaxed)};
+        if (h - tail.load(std::memory_order_acquire) == Size)
+            return false;
+
+        ring.construct(h % Size, std::move(elem));
+        head.store(h + 1, std::memory_order_seq_cst);
+
+        // Pairs with receive_many_impl(): either the consumer sees the new head, or we see that it has emptied the
+        // ring and registered itself, so that it must be notified.
+        auto was_empty{tail.load(std::memory_order_seq_cst) == h};
+        auto consumer_to_notify{consumer.load(std::memory_order_seq_cst)};
+        if (was_empty and consumer_to_notify != nullptr)
+        {
+            BaseType_t higher_priority_task_woken{pdFALSE};
+            vTaskNotifyGiveFromISR(consumer_to_notify, &higher_priority_task_woken);
+            portYIELD_FROM_ISR(higher_priority_task_woken);
+        }
+        return true;
+    }
+
+    ElementType receive()
+    {
+        return *receive_impl(portMAX_DELAY);
+    }
+
+    std::optional<ElementType> receive(unsigned timeout_ms)
+    {
+        return receive_impl(pdMS_TO_TICKS(timeout_ms));
+    }
+
+    /**
+     * @brief Blocks until at least one element is available and then receives up to max elements at once.
+     * @return Number of elements written to the output iterator.
+     */
+    template<std::output_iterator<ElementType> OutputIt>
+    std::size_t receive_many(OutputIt out, std::size_t max)
+    {
+        return receive_many_impl(out, max, portMAX_DELAY);
+    }
+
+    //! @return Number of elements written to the output iterator; zero when timeout occurred.
+    template<std::output_iterator<ElementType> OutputIt>
+    std::size_t receive_many(OutputIt out, std::size_t max, unsigned timeout_ms)
+    {
+        return receive_many_impl(out, max, pdMS_TO_TICKS(timeout_ms));
+    }
+
+  private:
+    std::optional<ElementType> receive_impl(TickType_t timeout)
+    {
+        std::optional<ElementType> r;
+        receive_many_impl(&r, 1, timeout);
+        return r;
+    }
+
+    template<typename OutputIt>
+    std::size_t receive_many_impl(OutputIt out, std::size_t max, TickType_t timeout)
+    {
+        if (max == 0)
+            return 0;
+
+        consumer.store(xTaskGetCurrentTaskHandle(), std::memory_order_seq_cst);
+
+        TimeOut_t time_out;
+        vTaskSetTimeOutState(&time_out);
+        while (true)
+        {
+            auto t{tail.load(std::memory_order_relaxed)};
+            auto h{head.load(std::memory_order_seq_cst)};
+            std::size_t count{0};
+            for (; count < max and t != h; ++count)
+            {
+                // The tail is published before the element is written out, so when the output iterator throws,
+                // the slots already taken are never taken again.
+                auto elem{ring.take(t % Size)};
+                tail.store(++t, std::memory_order_seq_cst);
+                *out++ = std::move(elem);
+            }
+            if (count != 0)
+                return count;
+
+            if (xTaskCheckForTimeOut(&time_out, &timeout) == pdTRUE)
+                return 0;
+            ulTaskNotifyTake(pdTRUE, timeout);
+        }
+    }
+
+    //! Only the slots from the tail to the head hold live elements.
+    utils::uninitialized_array<ElementType, Size> ring;
+    std::atomic<unsigned> head{0}, tail{0};
+    std::atomic<TaskHandle_t> consumer{nullptr};
+};
+
+} // namespace freertos
+
+} // namespace jungles
+
+#endif /* FREERTOS_ISR_TO_TASK_QUEUE_HPP */
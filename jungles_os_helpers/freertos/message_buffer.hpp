@@ -0,0 +1,126 @@
+/**
+ * @file	message_buffer.hpp
+ * @brief	RAII wrapper for FreeRTOS message buffers, passing discrete messages of variable length.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef FREERTOS_MESSAGE_BUFFER_HPP
+#define FREERTOS_MESSAGE_BUFFER_HPP
+
+#include "FreeRTOS.h"
+#include "message_buffer.h"
+#include "projdefs.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace jungles
+{
+
+namespace freertos
+{
+
+/**
+ * @brief Buffer of messages of variable length, with a single writer and a single reader.
+ *
+ * Unlike in jungles::freertos::stream_buffer, the boundaries of the messages are kept: each receive gets exactly one
+ * message. Each message occupies its length plus sizeof(size_t) bytes of the capacity. The storage is a part of the
+ * object.
+ *
+ * \tparam Capacity Number of bytes, including the length fields, which can be held at once.
+ */
+template<std::size_t Capacity>
+class message_buffer
+{
+  public:
+    message_buffer() : handle{xMessageBufferCreateStatic(Capacity, storage, &message_buffer_storage)}
+    {
+        assert(handle != nullptr);
+    }
+
+    message_buffer(const message_buffer&) = delete;
+    message_buffer& operator=(const message_buffer&) = delete;
+    message_buffer(message_buffer&&) = delete;
+    message_buffer& operator=(message_buffer&&) = delete;
+
+    ~message_buffer()
+    {
+        vMessageBufferDelete(handle);
+    }
+
+    //! Blocks until there is space for the message. @return false when the message can never fit into the buffer.
+    bool send(std::span<const std::byte> message)
+    {
+        return xMessageBufferSend(handle, message.data(), message.size(), portMAX_DELAY) == message.size();
+    }
+
+    //! @return false when timeout occurred; nothing is written then.
+    bool send(std::span<const std::byte> message, unsigned timeout_ms)
+    {
+        return xMessageBufferSend(handle, message.data(), message.size(), pdMS_TO_TICKS(timeout_ms))
+            == message.size();
+    }
+
+    //! Call from ISR context only. @return false when there is no space for the message.
+    bool send_from_isr(std::span<const std::byte> message)
+    {
+        BaseType_t higher_priority_task_woken{pdFALSE};
+        auto r{xMessageBufferSendFromISR(handle, message.data(), message.size(), &higher_priority_task_woken)};
+        portYIELD_FROM_ISR(higher_priority_task_woken);
+        return r == message.size();
+    }
+
+    /**
+     * @brief Blocks until a message is available.
+     * @return Length of the message; 0 when the buffer is too small for the message, which is then left in place.
+     */
+    std::size_t receive(std::span<std::byte> buffer)
+    {
+        return xMessageBufferReceive(handle, buffer.data(), buffer.size(), portMAX_DELAY);
+    }
+
+    //! @return Length of the message; 0 when timeout occurred or when the buffer is too small for the message.
+    std::size_t receive(std::span<std::byte> buffer, unsigned timeout_ms)
+    {
+        return xMessageBufferReceive(handle, buffer.data(), buffer.size(), pdMS_TO_TICKS(timeout_ms));
+    }
+
+    //! Call from ISR context only. @return Length of the message; 0 when there is none, or the buffer is too small.
+    std::size_t receive_from_isr(std::span<std::byte> buffer)
+    {
+        BaseType_t higher_priority_task_woken{pdFALSE};
+        auto r{xMessageBufferReceiveFromISR(handle, buffer.data(), buffer.size(), &higher_priority_task_woken)};
+        portYIELD_FROM_ISR(higher_priority_task_woken);
+        return r;
+    }
+
+    //! @return Length of the next message, so that a buffer of the right size can be provided; 0 when empty.
+    std::size_t next_message_size() const
+    {
+        return xMessageBufferNextLengthBytes(handle);
+    }
+
+    std::size_t space_available() const
+    {
+        return xMessageBufferSpacesAvailable(handle);
+    }
+
+    //! Drops all the messages. Succeeds only when no task is blocked on the buffer.
+    bool reset()
+    {
+        return xMessageBufferReset(handle) == pdPASS;
+    }
+
+  private:
+    // FreeRTOS requires one byte more than the capacity.
+    std::uint8_t storage[Capacity + 1];
+    StaticMessageBuffer_t message_buffer_storage;
+    MessageBufferHandle_t handle;
+};
+
+} // namespace freertos
+
+} // namespace jungles
+
+#endif /* FREERTOS_MESSAGE_BUFFER_HPP */
@@ -10,13 +10,20 @@
 #include "projdefs.h"
 #include "queue.h"
 #include "semphr.h"
+#include "task.h"
 
 #include "lockguard.hpp"
 
 #include <array>
 #include <exception>
+#include <iterator>
 #include <optional>
+#include <ranges>
 #include <type_traits>
+#include <utility>
+
+#include "jungles_os_helpers/utils/error.hpp"
+#include "jungles_os_helpers/utils/uninitialized_array.hpp"
 
 namespace jungles
 {
@@ -24,8 +31,25 @@ namespace jungles
 namespace freertos
 {
 
+template<typename... Queues>
+class queue_selector;
+
+/**
+ * @brief Multi-producer, multi-consumer queue with a fixed capacity.
+ *
+ * The depot is protected with a mutex. Receivers are woken up with a binary semaphore which acts as a "not empty"
+ * token: a producer gives it when the depot becomes non-empty, and a receiver which took it passes it on, when there are
+ * still elements left after it has received. Thanks to that, a batch of elements costs a single mutex round-trip and
+ * at most one semaphore give, no matter how many elements are transferred.
+ *
+ * Producers which wait for free space use a "not full" token in the same way: a receiver gives it when the depot stops
+ * being full, and a producer which took it passes it on, when there is still space left after it has sent.
+ *
+ * The slots are taken from the depot in index order, and published to the receivers in the same order. An element
+ * filled in place, after reserve(), holds back the elements sent after its reservation until it is committed or
+ * dropped.
+ */
 template<typename ElementType, std::size_t Size>
-    requires std::is_default_constructible_v<ElementType>
 class queue
 {
   public:
@@ -38,45 +62,234 @@ class queue
 
     queue() :
         queue_depot_mux{xSemaphoreCreateMutexStatic(&queue_depot_mux_storage)},
-        num_elements_counting_sem{xSemaphoreCreateCountingStatic(Size, 0, &num_elements_counting_sem_storage)}
+        not_empty_sem{xSemaphoreCreateBinaryStatic(&not_empty_sem_storage)},
+        not_full_sem{xSemaphoreCreateBinaryStatic(&not_full_sem_storage)}
     {
         assert(queue_depot_mux != nullptr);
-        assert(num_elements_counting_sem != nullptr);
+        assert(not_empty_sem != nullptr);
+        assert(not_full_sem != nullptr);
+        give_not_full();
     }
 
     ~queue()
     {
+        destroy_remaining_lock_free();
         vSemaphoreDelete(queue_depot_mux);
-        vSemaphoreDelete(num_elements_counting_sem);
+        vSemaphoreDelete(not_empty_sem);
+        vSemaphoreDelete(not_full_sem);
     }
 
-    void send(ElementType&& elem)
+    //! @return false when the queue is full, in the exception-free mode; otherwise queue_full_error is thrown.
+    bool send(ElementType&& elem)
     {
-        insert(std::move(elem));
+        lockguard g(queue_depot_mux);
+        if (queue_depot_slot_count == Size)
+            return utils::report_error<queue_full_error>(false);
 
-        [[maybe_unused]] auto r{xSemaphoreGive(num_elements_counting_sem)};
-        assert(r == pdTRUE);
+        insert_lock_free(std::move(elem));
+        if (publish_lock_free())
+            give_not_empty();
+        return true;
+    }
+
+    /**
+     * @brief Waits for free space up to the timeout, instead of throwing when the queue is full.
+     * @return false when timeout occurred; the element is not moved then.
+     */
+    bool send(ElementType&& elem, unsigned timeout_ms)
+    {
+        TickType_t timeout{pdMS_TO_TICKS(timeout_ms)};
+        TimeOut_t time_out;
+        vTaskSetTimeOutState(&time_out);
+        while (true)
+        {
+            if (xSemaphoreTake(not_full_sem, timeout) != pdTRUE)
+                return false;
+
+            {
+                lockguard g(queue_depot_mux);
+                // The non-waiting producers might have filled the depot, although the token was given.
+                if (queue_depot_slot_count != Size)
+                {
+                    insert_lock_free(std::move(elem));
+                    if (publish_lock_free())
+                        give_not_empty();
+                    if (queue_depot_slot_count != Size)
+                        give_not_full();
+                    return true;
+                }
+            }
+
+            if (xTaskCheckForTimeOut(&time_out, &timeout) == pdTRUE)
+                return false;
+        }
+    }
+
+    //! @return false when the queue is full; the element is not moved then.
+    bool try_send(ElementType&& elem)
+    {
+        lockguard g(queue_depot_mux);
+        if (queue_depot_slot_count == Size)
+            return false;
+
+        insert_lock_free(std::move(elem));
+        if (publish_lock_free())
+            give_not_empty();
+        return true;
+    }
+
+    /**
+     * @brief Sends all the elements from the range under a single lock and with a single notification.
+     *
+     * The elements are moved out of the range. Either all the elements are sent, or none, when there is not enough
+     * space in the queue.
+     *
+     * @return false when nothing was sent, in the exception-free mode; otherwise queue_full_error is thrown.
+     */
+    template<std::ranges::sized_range Range>
+    bool send_many(Range&& elems)
+    {
+        lockguard g(queue_depot_mux);
+        if (std::ranges::size(elems) > Size - queue_depot_slot_count)
+            return utils::report_error<queue_full_error>(false);
+
+        for (auto&& elem : elems)
+            insert_lock_free(std::move(elem));
+
+        if (publish_lock_free())
+            give_not_empty();
+        return true;
     }
 
-    void send_from_isr(ElementType&& elem)
+    class reserved_slot;
+    class peeked_slot;
+
+    /**
+     * @brief Takes a slot at the head of the queue and constructs an element in it, to be filled in place.
+     *
+     * Lets large elements be filled where they are stored, instead of being moved into the queue. The depot is locked
+     * only while the slot is taken, so the other producers and the receivers aren't blocked while the element is being
+     * filled. The element is published with reserved_slot::commit(); a slot destroyed without commit() is dropped.
+     *
+     * @return std::nullopt when the queue is full.
+     */
+    template<typename... Args>
+    std::optional<reserved_slot> try_reserve(Args&&... args)
+    {
+        unsigned index;
+        {
+            lockguard g(queue_depot_mux);
+            if (queue_depot_slot_count == Size)
+                return std::nullopt;
+            index = take_head_slot_lock_free();
+        }
+
+#if JUNGLES_OS_HELPERS_EXCEPTIONS_ENABLED
+        try
+        {
+            queue_depot.construct(index, std::forward<Args>(args)...);
+        } catch (...)
+        {
+            publish(index, slot_state::dropped);
+            throw;
+        }
+#else
+        queue_depot.construct(index, std::forward<Args>(args)...);
+#endif
+        return reserved_slot{*this, index};
+    }
+
+#if JUNGLES_OS_HELPERS_EXCEPTIONS_ENABLED
+    //! Same as try_reserve(), but throws queue_full_error when the queue is full.
+    template<typename... Args>
+    reserved_slot reserve(Args&&... args)
+    {
+        if (auto slot{try_reserve(std::forward<Args>(args)...)})
+            return std::move(*slot);
+        throw queue_full_error{};
+    }
+#endif
+
+    //! Element constructed in place with try_reserve() or reserve(), owned by the producer until it is published.
+    class reserved_slot
+    {
+      public:
+        reserved_slot(reserved_slot&& other) noexcept : q{std::exchange(other.q, nullptr)}, index{other.index}
+        {
+        }
+
+        reserved_slot& operator=(reserved_slot&&) = delete;
+
+        ~reserved_slot()
+        {
+            if (q != nullptr)
+            {
+                q->queue_depot.destroy(index);
+                q->publish(index, slot_state::dropped);
+            }
+        }
+
+        ElementType& operator*() const
+        {
+            return q->queue_depot[index];
+        }
+
+        ElementType* operator->() const
+        {
+            return &q->queue_depot[index];
+        }
+
+        void commit()
+        {
+            std::exchange(q, nullptr)->publish(index, slot_state::committed);
+        }
+
+      private:
+        friend class queue;
+
+        reserved_slot(queue& q, unsigned index) : q{&q}, index{index}
+        {
+        }
+
+        queue* q;
+        unsigned index;
+    };
+
+    /**
+     * @brief Drops the element when the queue is full, or when a task holds the depot mutex.
+     *
+     * Use jungles::freertos::isr_to_task_queue when the elements sent from an ISR must not be lost.
+     *
+     * @return false when the element was dropped.
+     */
+    bool send_from_isr(ElementType&& elem)
     {
         BaseType_t higher_priority_task_woken1{pdFALSE}, higher_priority_task_woken2{pdFALSE},
             higher_priority_task_woken3{pdFALSE};
 
+        bool is_sent{false};
         bool is_queue_depot_accessible{xSemaphoreTakeFromISR(queue_depot_mux, &higher_priority_task_woken1) == pdTRUE};
         if (is_queue_depot_accessible)
         {
-            insert_lock_free(std::move(elem));
-            xSemaphoreGiveFromISR(queue_depot_mux, &higher_priority_task_woken2);
-        }
+            auto has_become_non_empty{false};
+            if (queue_depot_slot_count != Size)
+            {
+                insert_lock_free(std::move(elem));
+                has_become_non_empty = publish_lock_free();
+                is_sent = true;
+            }
 
-        if (is_queue_depot_accessible)
-        {
-            [[maybe_unused]] auto r{xSemaphoreGiveFromISR(num_elements_counting_sem, &higher_priority_task_woken3)};
-            assert(r == pdTRUE);
+            if (has_become_non_empty)
+            {
+                [[maybe_unused]] auto r{xSemaphoreGiveFromISR(not_empty_sem, &higher_priority_task_woken2)};
+                assert(r == pdTRUE);
+            }
+
+            xSemaphoreGiveFromISR(queue_depot_mux, &higher_priority_task_woken3);
         }
 
         portYIELD_FROM_ISR(higher_priority_task_woken1 or higher_priority_task_woken2 or higher_priority_task_woken3);
+        return is_sent;
     }
 
     ElementType receive()
@@ -89,6 +302,149 @@ class queue
         return receive_impl(pdMS_TO_TICKS(timeout_ms));
     }
 
+    /**
+     * @brief Blocks until at least one element is available and then receives up to max elements at once.
+     * @return Number of elements written to the output iterator.
+     */
+    template<std::output_iterator<ElementType> OutputIt>
+    std::size_t receive_many(OutputIt out, std::size_t max)
+    {
+        return receive_many_impl(out, max, portMAX_DELAY);
+    }
+
+    //! @return Number of elements written to the output iterator; zero when timeout occurred.
+    template<std::output_iterator<ElementType> OutputIt>
+    std::size_t receive_many(OutputIt out, std::size_t max, unsigned timeout_ms)
+    {
+        return receive_many_impl(out, max, pdMS_TO_TICKS(timeout_ms));
+    }
+
+    /**
+     * @brief Receives an element without blocking. Call from ISR context only.
+     *
+     * Returns nothing when the queue is empty, or when a task accesses the depot at the moment.
+     */
+    std::optional<ElementType> receive_from_isr()
+    {
+        std::optional<ElementType> r;
+        receive_batch_from_isr<1>(&r);
+        return r;
+    }
+
+    /**
+     * @brief Receives up to MaxCount elements, which are available at the moment, in one pass. Call from ISR context
+     * only.
+     *
+     * Never blocks: when a task accesses the depot at the moment, nothing is received. The elements are moved to a
+     * buffer on the stack of the ISR first, so the depot is held for MaxCount element moves at most, and the output
+     * iterator is used once the depot is given back.
+     *
+     * @return Number of elements written to the output iterator.
+     */
+    template<std::size_t MaxCount, std::output_iterator<ElementType> OutputIt>
+    std::size_t receive_batch_from_isr(OutputIt out)
+    {
+        static_assert(MaxCount > 0, "Receive at least one element");
+
+        utils::uninitialized_array<ElementType, MaxCount> staged;
+
+        BaseType_t higher_priority_task_woken1{pdFALSE}, higher_priority_task_woken2{pdFALSE},
+            higher_priority_task_woken3{pdFALSE}, higher_priority_task_woken4{pdFALSE},
+            higher_priority_task_woken5{pdFALSE};
+
+        std::size_t count{0};
+        bool has_not_empty_token{xSemaphoreTakeFromISR(not_empty_sem, &higher_priority_task_woken1) == pdTRUE};
+        if (has_not_empty_token)
+        {
+            bool is_queue_depot_accessible{xSemaphoreTakeFromISR(queue_depot_mux, &higher_priority_task_woken2)
+                                           == pdTRUE};
+            if (is_queue_depot_accessible)
+            {
+                auto was_full{queue_depot_slot_count == Size};
+                for (; count < MaxCount and queue_depot_elem_count != 0; ++count)
+                    staged.construct(count, take_tail_lock_free());
+
+                if (was_full and queue_depot_slot_count != Size)
+                    xSemaphoreGiveFromISR(not_full_sem, &higher_priority_task_woken3);
+                if (queue_depot_elem_count != 0)
+                    xSemaphoreGiveFromISR(not_empty_sem, &higher_priority_task_woken4);
+
+                xSemaphoreGiveFromISR(queue_depot_mux, &higher_priority_task_woken5);
+            } else
+            {
+                // The elements are still there, so the token must be given back.
+                xSemaphoreGiveFromISR(not_empty_sem, &higher_priority_task_woken4);
+            }
+        }
+
+        for (std::size_t i{0}; i < count; ++i)
+            *out++ = staged.take(i);
+
+        portYIELD_FROM_ISR(higher_priority_task_woken1 or higher_priority_task_woken2 or higher_priority_task_woken3
+                           or higher_priority_task_woken4 or higher_priority_task_woken5);
+        return count;
+    }
+
+    /**
+     * @brief Blocks until an element is available and gives access to it in place.
+     *
+     * The element stays at the tail of the queue until peeked_slot::release() or the destruction of the returned
+     * object. The producers aren't blocked meanwhile, but the other receivers are.
+     */
+    peeked_slot peek()
+    {
+        return *peek_impl(portMAX_DELAY);
+    }
+
+    //! @return std::nullopt when timeout occurred.
+    std::optional<peeked_slot> peek(unsigned timeout_ms)
+    {
+        return peek_impl(pdMS_TO_TICKS(timeout_ms));
+    }
+
+    //! Element received in place with peek(). Holds the "not empty" token until it is released.
+    class peeked_slot
+    {
+      public:
+        peeked_slot(peeked_slot&& other) noexcept : q{std::exchange(other.q, nullptr)}, index{other.index}
+        {
+        }
+
+        peeked_slot& operator=(peeked_slot&&) = delete;
+
+        ~peeked_slot()
+        {
+            if (q != nullptr)
+                q->release(index);
+        }
+
+        ElementType& operator*() const
+        {
+            return q->queue_depot[index];
+        }
+
+        ElementType* operator->() const
+        {
+            return &q->queue_depot[index];
+        }
+
+        //! Removes the element from the queue.
+        void release()
+        {
+            std::exchange(q, nullptr)->release(index);
+        }
+
+      private:
+        friend class queue;
+
+        peeked_slot(queue& q, unsigned index) : q{&q}, index{index}
+        {
+        }
+
+        queue* q;
+        unsigned index;
+    };
+
     struct error : public std::exception
     {
     };
@@ -98,21 +454,127 @@ class queue
     };
 
   private:
-    void insert(ElementType&& elem)
+    template<typename... Queues>
+    friend class queue_selector;
+
+    enum class slot_state : unsigned char
     {
-        lockguard g(queue_depot_mux);
-        insert_lock_free(std::move(elem));
+        reserved,
+        committed,
+        dropped
+    };
+
+    //! Call only when the depot is not full. The slot is published with publish_lock_free().
+    unsigned take_head_slot_lock_free()
+    {
+        auto index{queue_depot_head};
+        slot_states[index] = slot_state::reserved;
+        increment_circular_buffer_index(queue_depot_head);
+        ++queue_depot_slot_count;
+        ++queue_depot_unpublished_count;
+        return index;
     }
 
+    //! Call only when the depot is not full.
     void insert_lock_free(ElementType&& elem)
     {
-        auto is_full{queue_depot_elem_count == Size};
-        if (is_full)
-            throw queue_full_error{};
+        auto index{take_head_slot_lock_free()};
+        queue_depot.construct(index, std::move(elem));
+        slot_states[index] = slot_state::committed;
+    }
 
-        queue_depot[queue_depot_head] = std::move(elem);
-        increment_circular_buffer_index(queue_depot_head);
-        ++queue_depot_elem_count;
+    /**
+     * @brief Publishes the unpublished slots in index order, up to the first one which is still reserved.
+     * @return true when the depot has become non-empty, so the "not empty" token must be given.
+     */
+    bool publish_lock_free()
+    {
+        auto was_empty{queue_depot_elem_count == 0};
+        for (; queue_depot_unpublished_count != 0 and slot_states[queue_depot_published] != slot_state::reserved;
+             --queue_depot_unpublished_count)
+        {
+            if (slot_states[queue_depot_published] == slot_state::committed)
+                ++queue_depot_elem_count;
+            increment_circular_buffer_index(queue_depot_published);
+        }
+        free_dropped_tail_slots_lock_free();
+        return was_empty and queue_depot_elem_count != 0;
+    }
+
+    //! Finishes a reservation.
+    void publish(unsigned index, slot_state state)
+    {
+        lockguard g(queue_depot_mux);
+        auto was_full{queue_depot_slot_count == Size};
+        slot_states[index] = state;
+        if (publish_lock_free())
+            give_not_empty();
+        if (was_full)
+            give_not_full_if_freed();
+    }
+
+    /**
+     * @brief Frees the slots of the dropped reservations, which have been published at the tail.
+     *
+     * Keeps the tail slot committed whenever the depot is not empty, so the receivers needn't skip the dropped slots.
+     */
+    void free_dropped_tail_slots_lock_free()
+    {
+        while (queue_depot_slot_count != queue_depot_unpublished_count
+               and slot_states[queue_depot_tail] == slot_state::dropped)
+        {
+            increment_circular_buffer_index(queue_depot_tail);
+            --queue_depot_slot_count;
+        }
+    }
+
+    //! Call only when the depot is not empty.
+    ElementType pop_lock_free()
+    {
+        auto was_full{queue_depot_slot_count == Size};
+        auto r{take_tail_lock_free()};
+        if (was_full)
+            give_not_full_if_freed();
+        return r;
+    }
+
+    //! Call only when the depot is not empty. Doesn't wake up the producers waiting for free space.
+    ElementType take_tail_lock_free()
+    {
+        auto r{queue_depot.take(queue_depot_tail)};
+        free_tail_slot_lock_free();
+        return r;
+    }
+
+    //! Call only when the depot is not empty, once the tail element is destroyed.
+    void free_tail_slot_lock_free()
+    {
+        increment_circular_buffer_index(queue_depot_tail);
+        --queue_depot_slot_count;
+        --queue_depot_elem_count;
+        free_dropped_tail_slots_lock_free();
+    }
+
+    void release(unsigned index)
+    {
+        lockguard g(queue_depot_mux);
+        auto was_full{queue_depot_slot_count == Size};
+        queue_depot.destroy(index);
+        free_tail_slot_lock_free();
+        if (was_full)
+            give_not_full_if_freed();
+        pass_not_empty_token_on();
+    }
+
+    //! Only the reservations which are in progress are left undestroyed, yet none may outlive the queue.
+    void destroy_remaining_lock_free()
+    {
+        for (; queue_depot_slot_count != 0; --queue_depot_slot_count)
+        {
+            if (slot_states[queue_depot_tail] == slot_state::committed)
+                queue_depot.destroy(queue_depot_tail);
+            increment_circular_buffer_index(queue_depot_tail);
+        }
     }
 
     void increment_circular_buffer_index(unsigned& index)
@@ -120,14 +582,39 @@ class queue
         index = (index + 1) % Size;
     }
 
+    void give_not_empty()
+    {
+        [[maybe_unused]] auto r{xSemaphoreGive(not_empty_sem)};
+        assert(r == pdTRUE);
+    }
+
+    //! The token might already be given, when nobody waits for free space, so the result is irrelevant.
+    void give_not_full()
+    {
+        xSemaphoreGive(not_full_sem);
+    }
+
+    //! Must be called with the depot mutex taken, after slots have been freed in the depot which was full.
+    void give_not_full_if_freed()
+    {
+        if (queue_depot_slot_count != Size)
+            give_not_full();
+    }
+
+    //! Must be called with the depot mutex taken, by the receiver which holds the "not empty" token.
+    void pass_not_empty_token_on()
+    {
+        if (queue_depot_elem_count != 0)
+            give_not_empty();
+    }
+
     std::optional<ElementType> receive_impl(TickType_t timeout)
     {
-        if (xSemaphoreTake(num_elements_counting_sem, timeout) == pdTRUE)
+        if (xSemaphoreTake(not_empty_sem, timeout) == pdTRUE)
         {
             lockguard g(queue_depot_mux);
-            auto r{std::move(queue_depot[queue_depot_tail])};
-            increment_circular_buffer_index(queue_depot_tail);
-            --queue_depot_elem_count;
+            auto r{pop_lock_free()};
+            pass_not_empty_token_on();
             return r;
         } else
         {
@@ -135,13 +622,45 @@ class queue
         }
     }
 
-    //! @todo Shall be circular buffer.
-    std::array<ElementType, Size> queue_depot;
-    unsigned queue_depot_tail{0}, queue_depot_head{0}, queue_depot_elem_count{0};
+    std::optional<peeked_slot> peek_impl(TickType_t timeout)
+    {
+        if (xSemaphoreTake(not_empty_sem, timeout) != pdTRUE)
+            return std::nullopt;
+        // The producers only touch the head, and the other receivers wait for the "not empty" token, which is held
+        // until release(), so the tail element can be accessed without the mutex.
+        return peeked_slot{*this, queue_depot_tail};
+    }
+
+    template<typename OutputIt>
+    std::size_t receive_many_impl(OutputIt out, std::size_t max, TickType_t timeout)
+    {
+        if (max == 0 or xSemaphoreTake(not_empty_sem, timeout) != pdTRUE)
+            return 0;
+
+        lockguard g(queue_depot_mux);
+        std::size_t count{0};
+        for (; count < max and queue_depot_elem_count != 0; ++count)
+            *out++ = pop_lock_free();
+        pass_not_empty_token_on();
+        return count;
+    }
+
+    //! Only the committed slots, and the reserved ones once constructed, from the tail to the head hold live elements.
+    utils::uninitialized_array<ElementType, Size> queue_depot;
+    std::array<slot_state, Size> slot_states;
+    unsigned queue_depot_tail{0}, queue_depot_head{0}, queue_depot_published{0};
+    //! The receivers see the committed elements from the tail to the published index.
+    unsigned queue_depot_elem_count{0};
+    //! All the slots from the tail to the head, including the reserved, unpublished and dropped ones.
+    unsigned queue_depot_slot_count{0};
+    //! The slots from the published index to the head.
+    unsigned queue_depot_unpublished_count{0};
     SemaphoreHandle_t queue_depot_mux;
-    SemaphoreHandle_t num_elements_counting_sem;
+    SemaphoreHandle_t not_empty_sem;
+    SemaphoreHandle_t not_full_sem;
     StaticSemaphore_t queue_depot_mux_storage;
-    StaticSemaphore_t num_elements_counting_sem_storage;
+    StaticSemaphore_t not_empty_sem_storage;
+    StaticSemaphore_t not_full_sem_storage;
 };
 
 } // namespace freertos
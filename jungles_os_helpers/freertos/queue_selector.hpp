@@ -0,0 +1,144 @@
+/**
+ * @file	queue_selector.hpp
+ * @brief	Waits on multiple jungles::freertos::queue objects at once, on top of FreeRTOS queue sets.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef FREERTOS_QUEUE_SELECTOR_HPP
+#define FREERTOS_QUEUE_SELECTOR_HPP
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "semphr.h"
+
+#include "jungles_os_helpers/freertos/queue.hpp"
+#include "jungles_os_helpers/generic/select_order.hpp"
+
+#include <array>
+#include <cassert>
+#include <optional>
+#include <tuple>
+
+static_assert(configUSE_QUEUE_SETS == 1, "jungles::freertos::queue_selector requires configUSE_QUEUE_SETS == 1");
+
+namespace jungles
+{
+
+namespace freertos
+{
+
+/**
+ * @brief Blocks on a set of queues and tells which one is ready to be received from.
+ *
+ * The "not empty" semaphores of the queues are put into a FreeRTOS queue set. Every entry taken from the queue set is
+ * remembered, so that when several queues are ready at once, the order of serving them can be chosen.
+ *
+ * The queues must be received from only by the task which uses the selector, and only after the selector has returned
+ * them, since a FreeRTOS queue set must be read in lockstep with its members: exactly one receive() / receive_many()
+ * per index returned by wait().
+ */
+template<typename... Queues>
+class queue_selector
+{
+  public:
+    static constexpr std::size_t num_queues{sizeof...(Queues)};
+
+    static_assert(num_queues > 0, "Select from at least one queue");
+
+    explicit queue_selector(Queues&... queues) : queue_selector(generic::select_order::priority, queues...)
+    {
+    }
+
+    queue_selector(generic::select_order order, Queues&... queues) :
+        members{queues.not_empty_sem...}, queue_set{xQueueCreateSet(num_queues)}, picker{order}
+    {
+        assert(queue_set != nullptr);
+
+        for (auto member : members)
+        {
+            // Only an empty semaphore can be added to a queue set, so the token is taken away for a while. Giving it
+            // back posts the member to the set.
+            auto had_token{xSemaphoreTake(member, 0) == pdTRUE};
+            [[maybe_unused]] auto r{xQueueAddToSet(member, queue_set)};
+            assert(r == pdPASS);
+            if (had_token)
+                xSemaphoreGive(member);
+        }
+    }
+
+    queue_selector(const queue_selector&) = delete;
+    queue_selector& operator=(const queue_selector&) = delete;
+    queue_selector(queue_selector&&) = delete;
+    queue_selector& operator=(queue_selector&&) = delete;
+
+    ~queue_selector()
+    {
+        for (auto member : members)
+        {
+            auto had_token{xSemaphoreTake(member, 0) == pdTRUE};
+            xQueueRemoveFromSet(member, queue_set);
+            if (had_token)
+                xSemaphoreGive(member);
+        }
+        vQueueDelete(queue_set);
+    }
+
+    //! @return Index of the ready queue, in the order the queues were passed to the constructor.
+    std::size_t wait()
+    {
+        return *wait_impl(portMAX_DELAY);
+    }
+
+    //! @return Index of the ready queue, or std::nullopt on timeout.
+    std::optional<std::size_t> wait(unsigned timeout_ms)
+    {
+        return wait_impl(pdMS_TO_TICKS(timeout_ms));
+    }
+
+  private:
+    std::optional<std::size_t> wait_impl(TickType_t timeout)
+    {
+        // The set is drained before picking, so that a queue which became ready after the previous wait() is taken
+        // into account by the select order; the task blocks only when no queue is ready at all.
+        drain_queue_set();
+        if (auto idx{picker.pick(is_ready)}; idx)
+            return take(*idx);
+
+        auto member{xQueueSelectFromSet(queue_set, timeout)};
+        if (member == nullptr)
+            return std::nullopt;
+
+        mark_ready(member);
+        drain_queue_set();
+        return take(*picker.pick(is_ready));
+    }
+
+    void drain_queue_set()
+    {
+        for (QueueSetMemberHandle_t member; (member = xQueueSelectFromSet(queue_set, 0)) != nullptr;)
+            mark_ready(member);
+    }
+
+    void mark_ready(QueueSetMemberHandle_t member)
+    {
+        for (std::size_t i{0}; i < num_queues; ++i)
+            if (members[i] == member)
+                is_ready[i] = true;
+    }
+
+    std::size_t take(std::size_t idx)
+    {
+        is_ready[idx] = false;
+        return idx;
+    }
+
+    std::array<SemaphoreHandle_t, num_queues> members;
+    QueueSetHandle_t queue_set;
+    std::array<bool, num_queues> is_ready = {};
+    generic::ready_picker<num_queues> picker;
+};
+
+} // namespace freertos
+
+} // namespace jungles
+
+#endif /* FREERTOS_QUEUE_SELECTOR_HPP */
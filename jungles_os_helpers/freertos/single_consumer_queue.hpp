@@ -0,0 +1,304 @@
+/**
+ * @file	single_consumer_queue.hpp
+ * @brief	Queue with a single consumer, woken up with direct-to-task notifications, for FreeRTOS.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef FREERTOS_SINGLE_CONSUMER_QUEUE_HPP
+#define FREERTOS_SINGLE_CONSUMER_QUEUE_HPP
+
+#include "FreeRTOS.h"
+#include "projdefs.h"
+#include "semphr.h"
+#include "task.h"
+
+#include <algorithm>
+#include <cassert>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+
+#include "jungles_os_helpers/utils/error.hpp"
+#include "jungles_os_helpers/utils/uninitialized_array.hpp"
+
+namespace jungles
+{
+
+namespace freertos
+{
+
+/**
+ * @brief Multi-producer, single-consumer queue with a fixed capacity.
+ *
+ * Has the same interface as jungles::freertos::queue, but the depot is protected with a short critical section
+ * instead of a mutex, and the consumer is woken up with a direct-to-task notification instead of a semaphore. Thus,
+ * sending an element costs a critical section, plus a notification only when the queue was empty, and receiving
+ * from a non-empty queue costs a critical section alone. Fits the mailboxes of actives, which have exactly one
+ * consumer. The producers which wait for free space, in the timed send(), block on a semaphore, which the consumer
+ * gives only when there are such producers.
+ *
+ * Only one task may receive from the queue. The receiving task shall not use the notification value (index 0) of its
+ * own for any other purpose.
+ */
+template<typename ElementType, std::size_t Size>
+class single_consumer_queue
+{
+  public:
+    static_assert(Size > 1, "This implementation will not work with size smaller than 2");
+
+    single_consumer_queue() : not_full_sem{xSemaphoreCreateBinaryStatic(&not_full_sem_storage)}
+    {
+        assert(not_full_sem != nullptr);
+    }
+
+    single_consumer_queue(const single_consumer_queue&) = delete;
+    single_consumer_queue& operator=(const single_consumer_queue&) = delete;
+    single_consumer_queue(single_consumer_queue&&) = delete;
+    single_consumer_queue& operator=(single_consumer_queue&&) = delete;
+
+    ~single_consumer_queue()
+    {
+        destroy_remaining_lock_free();
+        vSemaphoreDelete(not_full_sem);
+    }
+
+    //! @return false when the queue is full, in the exception-free mode; otherwise queue_full_error is thrown.
+    bool send(ElementType&& elem)
+    {
+        if (!try_send(std::move(elem)))
+            return utils::report_error<queue_full_error>(false);
+        return true;
+    }
+
+    /**
+     * @brief Waits for free space up to the timeout, instead of throwing when the queue is full.
+     *
+     * A producer which finds the queue full registers itself as waiting, under the same critical section, and blocks
+     * on the "not full" semaphore, which the consumer gives once it frees the slots. A woken producer passes the
+     * semaphore on to the next waiting one, when there is still free space.
+     *
+     * @return false when timeout occurred; the element is not moved then.
+     */
+    bool send(ElementType&& elem, unsigned timeout_ms)
+    {
+        TickType_t timeout{pdMS_TO_TICKS(timeout_ms)};
+        TimeOut_t time_out;
+        vTaskSetTimeOutState(&time_out);
+        while (true)
+        {
+            taskENTER_CRITICAL();
+            if (queue_depot_elem_count != Size)
+            {
+                insert_lock_free(std::move(elem));
+                auto consumer_to_notify{queue_depot_elem_count == 1 ? consumer : nullptr};
+                auto is_not_full_passed_on{queue_depot_elem_count != Size and num_waiting_producers != 0};
+                taskEXIT_CRITICAL();
+
+                if (is_not_full_passed_on)
+                    xSemaphoreGive(not_full_sem);
+                if (consumer_to_notify != nullptr)
+                    xTaskNotifyGive(consumer_to_notify);
+                return true;
+            }
+            ++num_waiting_producers;
+            taskEXIT_CRITICAL();
+
+            auto is_timeout{xTaskCheckForTimeOut(&time_out, &timeout) == pdTRUE};
+            if (!is_timeout)
+                xSemaphoreTake(not_full_sem, timeout);
+
+            taskENTER_CRITICAL();
+            --num_waiting_producers;
+            taskEXIT_CRITICAL();
+
+            if (is_timeout)
+                return false;
+        }
+    }
+
+    //! @return false when the queue is full; the element is not moved then.
+    bool try_send(ElementType&& elem)
+    {
+        taskENTER_CRITICAL();
+        if (queue_depot_elem_count == Size)
+        {
+            taskEXIT_CRITICAL();
+            return false;
+        }
+        insert_lock_free(std::move(elem));
+        auto consumer_to_notify{queue_depot_elem_count == 1 ? consumer : nullptr};
+        taskEXIT_CRITICAL();
+
+        if (consumer_to_notify != nullptr)
+            xTaskNotifyGive(consumer_to_notify);
+        return true;
+    }
+
+    //! @return false, when the queue is full; the element is not moved then.
+    bool send_from_isr(ElementType&& elem)
+    {
+        auto interrupt_status{taskENTER_CRITICAL_FROM_ISR()};
+        if (queue_depot_elem_count == Size)
+        {
+            taskEXIT_CRITICAL_FROM_ISR(interrupt_status);
+            return false;
+        }
+        insert_lock_free(std::move(elem));
+        auto consumer_to_notify{queue_depot_elem_count == 1 ? consumer : nullptr};
+        taskEXIT_CRITICAL_FROM_ISR(interrupt_status);
+
+        BaseType_t higher_priority_task_woken{pdFALSE};
+        if (consumer_to_notify != nullptr)
+            vTaskNotifyGiveFromISR(consumer_to_notify, &higher_priority_task_woken);
+        portYIELD_FROM_ISR(higher_priority_task_woken);
+        return true;
+    }
+
+    ElementType receive()
+    {
+        return *receive_impl(portMAX_DELAY);
+    }
+
+    std::optional<ElementType> receive(unsigned timeout_ms)
+    {
+        return receive_impl(pdMS_TO_TICKS(timeout_ms));
+    }
+
+    /**
+     * @brief Blocks until at least one element is available and then receives up to max elements at once.
+     * @return Number of elements written to the output iterator.
+     */
+    template<std::output_iterator<ElementType> OutputIt>
+    std::size_t receive_many(OutputIt out, std::size_t max)
+    {
+        return receive_many_impl(out, max, portMAX_DELAY);
+    }
+
+    //! @return Number of elements written to the output iterator; zero when timeout occurred.
+    template<std::output_iterator<ElementType> OutputIt>
+    std::size_t receive_many(OutputIt out, std::size_t max, unsigned timeout_ms)
+    {
+        return receive_many_impl(out, max, pdMS_TO_TICKS(timeout_ms));
+    }
+
+    struct error : public std::exception
+    {
+    };
+
+    struct queue_full_error : public error
+    {
+    };
+
+  private:
+    void insert_lock_free(ElementType&& elem)
+    {
+        queue_depot.construct(queue_depot_head, std::move(elem));
+        increment_circular_buffer_index(queue_depot_head);
+        ++queue_depot_elem_count;
+    }
+
+    //! Only the consumer moves the tail, and the slot stays counted in the depot, so the producers don't touch it.
+    ElementType take_from_tail()
+    {
+        auto r{queue_depot.take(queue_depot_tail)};
+        increment_circular_buffer_index(queue_depot_tail);
+        return r;
+    }
+
+    //! Gives the slots of the taken elements back to the producers, also when the output iterator throws, and wakes
+    //! up a producer waiting for free space, if there is any.
+    struct taken_slots_release
+    {
+        ~taken_slots_release()
+        {
+            if (count == 0)
+                return;
+            taskENTER_CRITICAL();
+            queue.queue_depot_elem_count -= count;
+            auto are_producers_waiting{queue.num_waiting_producers != 0};
+            taskEXIT_CRITICAL();
+
+            if (are_producers_waiting)
+                xSemaphoreGive(queue.not_full_sem);
+        }
+
+        single_consumer_queue& queue;
+        std::size_t count{0};
+    };
+
+    void destroy_remaining_lock_free()
+    {
+        for (; queue_depot_elem_count != 0; --queue_depot_elem_count)
+        {
+            queue_depot.destroy(queue_depot_tail);
+            increment_circular_buffer_index(queue_depot_tail);
+        }
+    }
+
+    void increment_circular_buffer_index(unsigned& index)
+    {
+        index = (index + 1) % Size;
+    }
+
+    std::optional<ElementType> receive_impl(TickType_t timeout)
+    {
+        std::optional<ElementType> r;
+        receive_many_impl(&r, 1, timeout);
+        return r;
+    }
+
+    /**
+     * The consumer registers itself under the critical section, before it checks the depot, so a producer which
+     * fills the empty depot afterwards always sees whom to notify. A notification given while the consumer was not
+     * blocked only causes one spurious wake-up, after which the depot is checked again.
+     *
+     * The critical section only counts the available elements. They are moved out, destroyed and written to the output
+     * iterator afterwards, and their slots are given back to the producers at the end, so the time spent with the
+     * interrupts masked doesn't depend on max nor on the element type.
+     */
+    template<typename OutputIt>
+    std::size_t receive_many_impl(OutputIt out, std::size_t max, TickType_t timeout)
+    {
+        if (max == 0)
+            return 0;
+
+        TimeOut_t time_out;
+        vTaskSetTimeOutState(&time_out);
+        while (true)
+        {
+            taskENTER_CRITICAL();
+            consumer = xTaskGetCurrentTaskHandle();
+            auto count{std::min<std::size_t>(max, queue_depot_elem_count)};
+            taskEXIT_CRITICAL();
+
+            if (count != 0)
+            {
+                taken_slots_release taken{*this};
+                while (taken.count < count)
+                {
+                    auto elem{take_from_tail()};
+                    ++taken.count;
+                    *out++ = std::move(elem);
+                }
+                return count;
+            }
+            if (xTaskCheckForTimeOut(&time_out, &timeout) == pdTRUE)
+                return 0;
+            ulTaskNotifyTake(pdTRUE, timeout);
+        }
+    }
+
+    //! Only the slots from the tail to the head hold live elements.
+    utils::uninitialized_array<ElementType, Size> queue_depot;
+    unsigned queue_depot_tail{0}, queue_depot_head{0}, queue_depot_elem_count{0};
+    TaskHandle_t consumer{nullptr};
+    unsigned num_waiting_producers{0};
+    StaticSemaphore_t not_full_sem_storage;
+    SemaphoreHandle_t not_full_sem;
+};
+
+} // namespace freertos
+
+} // namespace jungles
+
+#endif /* FREERTOS_SINGLE_CONSUMER_QUEUE_HPP */
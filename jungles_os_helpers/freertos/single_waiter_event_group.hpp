@@ -0,0 +1,203 @@
+/**
+ * @file	single_waiter_event_group.hpp
+ * @brief	Event group with a single waiter, woken up with direct-to-task notifications, for FreeRTOS.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef FREERTOS_SINGLE_WAITER_EVENT_GROUP_HPP
+#define FREERTOS_SINGLE_WAITER_EVENT_GROUP_HPP
+
+#include "FreeRTOS.h"
+#include "projdefs.h"
+#include "task.h"
+
+#include <bit>
+#include <chrono>
+#include <optional>
+
+#include "jungles_os_helpers/freertos/event_group.hpp"
+#include "jungles_os_helpers/utils/enum_to_bits.hpp"
+#include "jungles_os_helpers/utils/event_set.hpp"
+
+namespace jungles
+{
+
+namespace freertos
+{
+
+/**
+ * @brief Event group with the same interface as jungles::freertos::event_group, for a single waiting task.
+ *
+ * The bits are kept under a short critical section and the waiter is woken up with a direct-to-task notification,
+ * so set_from_isr() sets the bits in the interrupt itself, instead of deferring it to the timer daemon task. Since
+ * the bits are not owned by the kernel, all the bits of Bits are available for the events.
+ *
+ * Only one task may wait on the group. The waiting task shall not use the notification value (index 0) of its own
+ * for any other purpose.
+ */
+template<auto... Events>
+class single_waiter_event_group
+{
+  private:
+    using EnumToBits = utils::EnumToBits<Bits, Events...>;
+    using EnumType = typename EnumToBits::value_type;
+
+  public:
+    using EventSet = utils::event_set<EnumType, Bits>;
+
+    single_waiter_event_group() = default;
+    single_waiter_event_group(const single_waiter_event_group&) = delete;
+    single_waiter_event_group& operator=(const single_waiter_event_group&) = delete;
+    single_waiter_event_group(single_waiter_event_group&&) = delete;
+    single_waiter_event_group& operator=(single_waiter_event_group&&) = delete;
+
+    template<auto... Evts>
+    void set()
+    {
+        constexpr auto bits{EnumToBits::template to_bits<Evts...>()};
+        taskENTER_CRITICAL();
+        auto waiter_to_notify{set_lock_free(bits)};
+        taskEXIT_CRITICAL();
+
+        if (waiter_to_notify != nullptr)
+            xTaskNotifyGive(waiter_to_notify);
+    }
+
+    //! Sets the events in the interrupt itself and wakes up the waiter directly.
+    template<auto... Evts>
+    void set_from_isr()
+    {
+        constexpr auto bits{EnumToBits::template to_bits<Evts...>()};
+        auto interrupt_status{taskENTER_CRITICAL_FROM_ISR()};
+        auto waiter_to_notify{set_lock_free(bits)};
+        taskEXIT_CRITICAL_FROM_ISR(interrupt_status);
+
+        BaseType_t higher_priority_task_woken{pdFALSE};
+        if (waiter_to_notify != nullptr)
+            vTaskNotifyGiveFromISR(waiter_to_notify, &higher_priority_task_woken);
+        portYIELD_FROM_ISR(higher_priority_task_woken);
+    }
+
+    Bits get()
+    {
+        taskENTER_CRITICAL();
+        auto r{events};
+        taskEXIT_CRITICAL();
+        return r;
+    }
+
+    template<auto... Evts>
+    void clear()
+    {
+        constexpr auto bits{EnumToBits::template to_bits<Evts...>()};
+        taskENTER_CRITICAL();
+        events &= ~bits;
+        taskEXIT_CRITICAL();
+    }
+
+    //! Waits for any of the events and clears the received one.
+    template<auto... Evts>
+    EnumType wait_one()
+    {
+        constexpr auto bits{EnumToBits::template to_bits<Evts...>()};
+        return to_enum(wait_impl(portMAX_DELAY, [](Bits set) { return set & bits & -(set & bits); }));
+    }
+
+    template<auto... Evts>
+    std::optional<EnumType> wait_one(std::chrono::milliseconds timeout)
+    {
+        constexpr auto bits{EnumToBits::template to_bits<Evts...>()};
+        auto event_bit{wait_impl(to_ticks(timeout), [](Bits set) { return set & bits & -(set & bits); })};
+        if (event_bit != 0)
+            return to_enum(event_bit);
+        else
+            return std::nullopt;
+    }
+
+    //! Waits for any of the events and returns all the awaited events which are set, clearing them.
+    template<auto... Evts>
+    EventSet wait_any()
+    {
+        constexpr auto bits{EnumToBits::template to_bits<Evts...>()};
+        return EventSet{wait_impl(portMAX_DELAY, [](Bits set) { return set & bits; })};
+    }
+
+    //! Returns an empty set on timeout.
+    template<auto... Evts>
+    EventSet wait_any(std::chrono::milliseconds timeout)
+    {
+        constexpr auto bits{EnumToBits::template to_bits<Evts...>()};
+        return EventSet{wait_impl(to_ticks(timeout), [](Bits set) { return set & bits; })};
+    }
+
+    //! Waits until all the events are set and clears them.
+    template<auto... Evts>
+    void wait_all()
+    {
+        constexpr auto bits{EnumToBits::template to_bits<Evts...>()};
+        wait_impl(portMAX_DELAY, [](Bits set) { return (set & bits) == bits ? bits : 0; });
+    }
+
+    //! @return false on timeout, in which case none of the events is cleared.
+    template<auto... Evts>
+    bool wait_all(std::chrono::milliseconds timeout)
+    {
+        constexpr auto bits{EnumToBits::template to_bits<Evts...>()};
+        return wait_impl(to_ticks(timeout), [](Bits set) { return (set & bits) == bits ? bits : 0; }) != 0;
+    }
+
+  private:
+    //! Call only within a critical section. Returns the waiter to notify, if the bits may complete its wait.
+    TaskHandle_t set_lock_free(Bits bits)
+    {
+        auto newly_set{bits & ~events};
+        events |= bits;
+        return newly_set != 0 ? waiter : nullptr;
+    }
+
+    /**
+     * The waiter registers itself under the critical section, before it checks the bits, so a task or an interrupt
+     * which sets the bits afterwards always sees whom to notify. A notification which doesn't complete the wait only
+     * causes one spurious wake-up, after which the bits are checked again.
+     *
+     * \param select Returns the bits to take out of the set ones, or 0 when the wait condition is not met.
+     */
+    template<typename Select>
+    Bits wait_impl(TickType_t timeout, Select select)
+    {
+        TimeOut_t time_out;
+        vTaskSetTimeOutState(&time_out);
+        while (true)
+        {
+            taskENTER_CRITICAL();
+            waiter = xTaskGetCurrentTaskHandle();
+            auto taken{select(events)};
+            events &= ~taken;
+            taskEXIT_CRITICAL();
+
+            if (taken != 0)
+                return taken;
+            if (xTaskCheckForTimeOut(&time_out, &timeout) == pdTRUE)
+                return 0;
+            ulTaskNotifyTake(pdTRUE, timeout);
+        }
+    }
+
+    static TickType_t to_ticks(std::chrono::milliseconds timeout)
+    {
+        return pdMS_TO_TICKS(timeout.count());
+    }
+
+    static EnumType to_enum(Bits event_bit)
+    {
+        return static_cast<EnumType>(std::countr_zero(event_bit));
+    }
+
+    Bits events{0};
+    TaskHandle_t waiter{nullptr};
+};
+
+} // namespace freertos
+
+} // namespace jungles
+
+#endif /* FREERTOS_SINGLE_WAITER_EVENT_GROUP_HPP */
@@ -1,16 +1,16 @@
 /**
  * @file        event_group.cpp
- * @brief       Implements the Pimpl stuff for event_group to make the FreeRTOS  dependency private.
+ * @brief       Implements event_group on the inline storage, to keep the FreeRTOS dependency private.
  */
 
 #include "jungles_os_helpers/freertos/event_group.hpp"
 
 #include <chrono>
-#include <memory>
 
 #include "FreeRTOS.h"
 #include "event_groups.h"
 #include "portmacro.h"
+#include "task.h"
 
 namespace jungles::freertos
 {
@@ -18,96 +18,150 @@ namespace jungles::freertos
 namespace impl
 {
 
-struct event_group_impl
+static_assert(configSUPPORT_STATIC_ALLOCATION == 1, "event_group requires configSUPPORT_STATIC_ALLOCATION");
+// FreeRTOS.h derives configTICK_TYPE_WIDTH_IN_BITS from configUSE_16_BIT_TICKS, when only the latter is configured,
+// while event_group.hpp sees only FreeRTOSConfig.h. The top 8 bits of the tick type are the kernel's control bits.
+#ifdef configTICK_TYPE_WIDTH_IN_BITS
+static_assert(detail::max_event_bits()
+                  == (configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_16_BITS   ? 8
+                      : configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_32_BITS ? 24
+                                                                                 : 56),
+              "max_event_bits() doesn't match the configured tick width");
+#else
+static_assert(detail::max_event_bits() == (configUSE_16_BIT_TICKS == 1 ? 8 : 24),
+              "max_event_bits() doesn't match the configured tick width");
+#endif
+static_assert(detail::max_event_bits() < sizeof(Bits) * 8, "Bits can't hold all the event bits of the event group");
+static_assert(detail::max_event_bits() < sizeof(EventBits_t) * 8, "EventBits_t can't hold all the event bits");
+static_assert(sizeof(StaticEventGroup_t) <= sizeof(event_group_storage_layout),
+              "StaticEventGroup_t doesn't fit in the storage; update event_group_storage_layout");
+static_assert(alignof(StaticEventGroup_t) <= alignof(event_group_storage_layout),
+              "StaticEventGroup_t is over-aligned for the storage; update event_group_storage_layout");
+
+namespace
 {
-    event_group_impl() : handle{xEventGroupCreate()}
-    {
-    }
-
-    ~event_group_impl()
-    {
-        vEventGroupDelete(handle);
-    }
-
-    void set(Bits bits)
-    {
-        xEventGroupSetBits(handle, bits);
-    }
 
-    Bits get()
-    {
-        return xEventGroupGetBits(handle);
-    }
+//! xEventGroupCreateStatic() returns the pointer to the buffer it was given, so the handle needn't be stored.
+inline EventGroupHandle_t to_handle(std::byte* storage)
+{
+    return reinterpret_cast<EventGroupHandle_t>(storage);
+}
 
-    Bits wait_one(Bits bits)
-    {
-        return do_wait_one(bits);
-    }
+Bits do_wait(EventGroupHandle_t handle, Bits bits, BaseType_t clear_on_exit, BaseType_t wait_for_all, TickType_t delay)
+{
+    auto bits_set{xEventGroupWaitBits(handle, bits, clear_on_exit, wait_for_all, delay)};
+    return bits_set & bits;
+}
 
-    Bits wait_one(Bits bits, std::chrono::milliseconds timeout)
-    {
-        auto ticks{pdMS_TO_TICKS(timeout.count())};
-        return do_wait_one(bits, ticks);
-    }
+Bits do_wait_one(EventGroupHandle_t handle,
+                 Bits bits,
+                 TickType_t delay,
+                 event_group::select_function select,
+                 void* context)
+{
+    auto do_not_clear_on_exit{pdFALSE};
+    auto do_not_wait_for_all{pdFALSE};
 
-    void clear(Bits bits)
+    TimeOut_t timeout;
+    vTaskSetTimeOutState(&timeout);
+    while (true)
     {
-        xEventGroupClearBits(handle, bits);
-    }
+        auto bits_set{do_wait(handle, bits, do_not_clear_on_exit, do_not_wait_for_all, delay)};
+        if (bits_set == 0)
+            return 0;
 
-  private:
-    static inline Bits get_first_set_bit(Bits bits)
-    {
-        Bits mask{1};
-        while ((bits & mask) == 0)
-            mask <<= 1;
-        return mask;
-    }
+        // FreeRTOS can clear on exit only all the awaited bits, so the single bit is cleared afterwards. The value
+        // before the clear tells whether this call is the one which took the event; otherwise, another consumer
+        // took it in the meantime, so continue waiting.
+        auto event_bit{select(bits_set, context)};
+        if ((xEventGroupClearBits(handle, event_bit) & event_bit) != 0)
+            return event_bit;
 
-    Bits do_wait_one(Bits bits, TickType_t delay = portMAX_DELAY)
-    {
-        auto do_not_clear_on_exit{pdFALSE};
-        auto do_not_wait_for_all{pdFALSE};
-        auto bits_set{xEventGroupWaitBits(handle, bits, do_not_clear_on_exit, do_not_wait_for_all, delay)};
-        if (bits_set == 0 or (bits_set & bits) == 0)
+        if (delay != portMAX_DELAY and xTaskCheckForTimeOut(&timeout, &delay) == pdTRUE)
             return 0;
-        return get_first_set_bit(bits_set & bits);
     }
+}
 
-    EventGroupHandle_t handle;
-};
+} // namespace
 
-event_group::event_group() : pimpl{std::make_unique<event_group_impl>()}
+event_group::event_group()
 {
+    [[maybe_unused]] auto handle{xEventGroupCreateStatic(reinterpret_cast<StaticEventGroup_t*>(storage))};
+    configASSERT(handle == to_handle(storage));
 }
 
 event_group::~event_group()
 {
+    vEventGroupDelete(to_handle(storage));
 }
 
 void event_group::set(Bits bits)
 {
-    pimpl->set(bits);
+    xEventGroupSetBits(to_handle(storage), bits);
+}
+
+bool event_group::set_from_isr(Bits bits)
+{
+    BaseType_t higher_priority_task_woken{pdFALSE};
+    auto result{xEventGroupSetBitsFromISR(to_handle(storage), bits, &higher_priority_task_woken)};
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+    return result == pdPASS;
 }
 
 Bits event_group::get()
 {
-    return pimpl->get();
+    return xEventGroupGetBits(to_handle(storage));
+}
+
+Bits event_group::wait_one(Bits bits, select_function select, void* context)
+{
+    return do_wait_one(to_handle(storage), bits, portMAX_DELAY, select, context);
+}
+
+Bits event_group::wait_one(Bits bits, std::chrono::milliseconds timeout, select_function select, void* context)
+{
+    auto ticks{pdMS_TO_TICKS(timeout.count())};
+    return do_wait_one(to_handle(storage), bits, ticks, select, context);
 }
 
-Bits event_group::wait_one(Bits bits)
+Bits event_group::wait_any(Bits bits)
 {
-    return pimpl->wait_one(bits);
+    return do_wait(to_handle(storage), bits, pdTRUE, pdFALSE, portMAX_DELAY);
 }
 
-Bits event_group::wait_one(Bits bits, std::chrono::milliseconds timeout)
+Bits event_group::wait_any(Bits bits, std::chrono::milliseconds timeout)
 {
-    return pimpl->wait_one(bits, timeout);
+    auto ticks{pdMS_TO_TICKS(timeout.count())};
+    return do_wait(to_handle(storage), bits, pdTRUE, pdFALSE, ticks);
+}
+
+bool event_group::wait_all(Bits bits)
+{
+    return do_wait(to_handle(storage), bits, pdTRUE, pdTRUE, portMAX_DELAY) == bits;
+}
+
+bool event_group::wait_all(Bits bits, std::chrono::milliseconds timeout)
+{
+    auto ticks{pdMS_TO_TICKS(timeout.count())};
+    return do_wait(to_handle(storage), bits, pdTRUE, pdTRUE, ticks) == bits;
 }
 
 void event_group::clear(Bits bits)
 {
-    return pimpl->clear(bits);
+    xEventGroupClearBits(to_handle(storage), bits);
+}
+
+bool event_group::sync(Bits set, Bits wait_for)
+{
+    auto bits{xEventGroupSync(to_handle(storage), set, wait_for, portMAX_DELAY)};
+    return (bits & wait_for) == wait_for;
+}
+
+bool event_group::sync(Bits set, Bits wait_for, std::chrono::milliseconds timeout)
+{
+    auto ticks{pdMS_TO_TICKS(timeout.count())};
+    auto bits{xEventGroupSync(to_handle(storage), set, wait_for, ticks)};
+    return (bits & wait_for) == wait_for;
 }
 
 } // namespace impl
@@ -0,0 +1,228 @@
+/**
+ * @file	static_thread.hpp
+ * @brief	Implements a thread run on top of FreeRTOS, which doesn't use the heap at all.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef FREERTOS_STATIC_THREAD_HPP
+#define FREERTOS_STATIC_THREAD_HPP
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "jungles_os_helpers/freertos/thread.hpp"
+#include "jungles_os_helpers/freertos/thread_stats.hpp"
+#include "jungles_os_helpers/utils/error.hpp"
+
+namespace jungles
+{
+
+namespace freertos
+{
+
+/**
+ * @brief Thread with the same interface as jungles::freertos::thread, but without any heap allocation.
+ *
+ * The task control block, the stack, the name and the thread code are all stored within the object, and the task is
+ * created with xTaskCreateStatic(). Since the task runs on the memory of the object, the object must outlive the task,
+ * even when detached: the destructor waits for the task to finish and then deletes it.
+ *
+ * \tparam StackDepth Stack size in words, as passed to xTaskCreateStatic().
+ * \tparam CodeStorageSize Maximum size of the callable passed to start(), e.g. a lambda with its captures.
+ */
+template<std::size_t StackDepth, std::size_t CodeStorageSize = 4 * sizeof(void*)>
+class static_thread
+{
+  public:
+    using status = thread::status;
+    using error = thread::error;
+    using already_detached_error = thread::already_detached_error;
+    using already_joined_error = thread::already_joined_error;
+    using not_started_error = thread::not_started_error;
+
+    //! The name is truncated to configMAX_TASK_NAME_LEN - 1 characters.
+    static_thread(const char* name, int priority) : priority{priority}
+    {
+        std::strncpy(this->name, name, sizeof(this->name) - 1);
+    }
+
+    static_thread(const static_thread&) = delete;
+    static_thread& operator=(const static_thread&) = delete;
+    static_thread(static_thread&&) = delete;
+    static_thread& operator=(static_thread&&) = delete;
+
+    ~static_thread()
+    {
+        if (is_started and !is_task_deleted)
+        {
+            wait_finished();
+            delete_task();
+        }
+    }
+
+    template<typename Callable>
+    void start(Callable&& thread_code)
+    {
+        using Code = std::decay_t<Callable>;
+        static_assert(sizeof(Code) <= CodeStorageSize, "The thread code doesn't fit, increase CodeStorageSize");
+        static_assert(alignof(Code) <= alignof(std::max_align_t), "The thread code is over-aligned");
+
+        new (code_storage) Code(std::forward<Callable>(thread_code));
+        run_and_destroy_code = [](void* code) {
+            auto& c{*static_cast<Code*>(code)};
+            c();
+            c.~Code();
+        };
+
+        is_started = true;
+        handle = xTaskCreateStatic(task_fun, name, StackDepth, this, priority, stack, &task_control_block);
+        assert(handle != nullptr);
+    }
+
+    //! Uses the notification value (index 0) of the joining task, as jungles::freertos::thread::join() does. In the
+    //! exception-free mode the error is returned, otherwise the corresponding exception is thrown.
+    status join()
+    {
+        if (is_detached)
+            return utils::report_error<already_detached_error>(status::already_detached);
+        else if (is_joined)
+            return status::ok;
+        else if (!is_started)
+            return utils::report_error<not_started_error>(status::not_started);
+
+        wait_finished();
+        delete_task();
+
+        is_joined = true;
+        return status::ok;
+    }
+
+    //! In the exception-free mode the error is returned, otherwise the corresponding exception is thrown.
+    status detach()
+    {
+        if (is_detached)
+            return utils::report_error<already_detached_error>(status::already_detached);
+        else if (is_joined)
+            return utils::report_error<already_joined_error>(status::already_joined);
+        else if (!is_started)
+            return utils::report_error<not_started_error>(status::not_started);
+
+        taskENTER_CRITICAL();
+        auto is_finished{state == task_state::finished};
+        taskEXIT_CRITICAL();
+
+        // A task which has already finished is reclaimed right away, otherwise the destructor waits for it.
+        if (is_finished)
+            delete_task();
+
+        is_detached = true;
+        return status::ok;
+    }
+
+    //! Samples the statistics of the task; the CPU share is computed since the previous call. Once the task is
+    //! deleted, the statistics sampled right before the deletion are returned, with the state eDeleted.
+    thread_stats stats()
+    {
+        if (!is_started)
+            return {};
+        if (is_task_deleted)
+            return final_stats;
+        return sampler.sample(handle);
+    }
+
+  private:
+    static void task_fun(void* raw_pointer_to_self)
+    {
+        auto& self{*static_cast<static_thread*>(raw_pointer_to_self)};
+        self.run_and_destroy_code(self.code_storage);
+
+        // The joiner is notified within the critical section, see wait_finished(). This is the last notification
+        // before the task suspends itself, so the joiner is woken up right before the task can be deleted.
+        taskENTER_CRITICAL();
+        self.state = task_state::finished;
+        if (self.joiner != nullptr)
+            xTaskNotifyGive(self.joiner);
+        taskEXIT_CRITICAL();
+
+        // The task control block and the stack are still in use here, so the task is deleted by the owner of the
+        // memory, once the task is suspended.
+        vTaskSuspend(nullptr);
+    }
+
+    void wait_finished()
+    {
+        taskENTER_CRITICAL();
+        auto is_finished{state == task_state::finished};
+        if (!is_finished)
+            joiner = xTaskGetCurrentTaskHandle();
+        taskEXIT_CRITICAL();
+
+        // The notification value may be shared with other users of ulTaskNotifyTake() running on the joining task,
+        // so the state is checked again after each wake-up. The task notifies the registered joiner within the same
+        // critical section in which it finishes, so once the task is seen finished, the notification has been given.
+        // It is consumed then, even if the last wake-up was caused by another user, so that it doesn't wake up the
+        // joining task later on.
+        if (!is_finished)
+        {
+            do
+            {
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+                taskENTER_CRITICAL();
+                is_finished = state == task_state::finished;
+                taskEXIT_CRITICAL();
+            } while (!is_finished);
+            ulTaskNotifyTake(pdTRUE, 0);
+        }
+    }
+
+    /**
+     * The task still runs on the memory of this object for a moment after it signals that it has finished: the
+     * notification wakes up the joiner right before the task suspends itself. A joiner of a higher priority preempts
+     * the task in this window, so it sleeps a tick at a time, rather than busy polls, to let the task reach
+     * vTaskSuspend().
+     */
+    void delete_task()
+    {
+        while (eTaskGetState(handle) != eSuspended)
+            vTaskDelay(1);
+
+        // The handle is not passed to the kernel after the task is deleted.
+        final_stats = sampler.sample(handle);
+        final_stats.state = eDeleted;
+        vTaskDelete(handle);
+        is_task_deleted = true;
+    }
+
+    enum class task_state
+    {
+        running,
+        finished
+    };
+
+    StaticTask_t task_control_block;
+    StackType_t stack[StackDepth];
+    alignas(std::max_align_t) unsigned char code_storage[CodeStorageSize];
+    void (*run_and_destroy_code)(void*){nullptr};
+    char name[configMAX_TASK_NAME_LEN] = {};
+    TaskHandle_t handle{nullptr};
+    TaskHandle_t joiner{nullptr};
+    detail::thread_stats_sampler sampler;
+    thread_stats final_stats;
+    task_state state{task_state::running};
+    int priority;
+    bool is_detached{false};
+    bool is_joined{false};
+    bool is_started{false};
+    bool is_task_deleted{false};
+};
+
+} // namespace freertos
+} // namespace jungles
+
+#endif /* FREERTOS_STATIC_THREAD_HPP */
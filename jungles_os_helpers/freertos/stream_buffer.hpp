@@ -0,0 +1,129 @@
+/**
+ * @file	stream_buffer.hpp
+ * @brief	RAII wrapper for FreeRTOS stream buffers, passing byte streams of variable length.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef FREERTOS_STREAM_BUFFER_HPP
+#define FREERTOS_STREAM_BUFFER_HPP
+
+#include "FreeRTOS.h"
+#include "projdefs.h"
+#include "stream_buffer.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace jungles
+{
+
+namespace freertos
+{
+
+/**
+ * @brief Byte stream of a fixed capacity, with a single writer and a single reader.
+ *
+ * The bytes are copied straight from the writer's span to the buffer and from the buffer to the reader's span, so
+ * variable-length data needs neither padding to a maximum element size nor allocation. The storage is a part of the
+ * object.
+ *
+ * \tparam Capacity Number of bytes which can be held at once.
+ */
+template<std::size_t Capacity>
+class stream_buffer
+{
+  public:
+    //! @param trigger_level Number of bytes which must be in the buffer, before a blocked reader is woken up.
+    explicit stream_buffer(std::size_t trigger_level = 1) :
+        handle{xStreamBufferCreateStatic(Capacity, trigger_level, storage, &stream_buffer_storage)}
+    {
+        assert(handle != nullptr);
+    }
+
+    stream_buffer(const stream_buffer&) = delete;
+    stream_buffer& operator=(const stream_buffer&) = delete;
+    stream_buffer(stream_buffer&&) = delete;
+    stream_buffer& operator=(stream_buffer&&) = delete;
+
+    ~stream_buffer()
+    {
+        vStreamBufferDelete(handle);
+    }
+
+    //! Blocks until there is space for all the data. @return Number of bytes written.
+    std::size_t send(std::span<const std::byte> data)
+    {
+        return xStreamBufferSend(handle, data.data(), data.size(), portMAX_DELAY);
+    }
+
+    //! @return Number of bytes written; when timeout occurred, only as many bytes as fit are written.
+    std::size_t send(std::span<const std::byte> data, unsigned timeout_ms)
+    {
+        return xStreamBufferSend(handle, data.data(), data.size(), pdMS_TO_TICKS(timeout_ms));
+    }
+
+    //! Call from ISR context only. @return Number of bytes written.
+    std::size_t send_from_isr(std::span<const std::byte> data)
+    {
+        BaseType_t higher_priority_task_woken{pdFALSE};
+        auto r{xStreamBufferSendFromISR(handle, data.data(), data.size(), &higher_priority_task_woken)};
+        portYIELD_FROM_ISR(higher_priority_task_woken);
+        return r;
+    }
+
+    //! Blocks until the trigger level is reached. @return Number of bytes read.
+    std::size_t receive(std::span<std::byte> buffer)
+    {
+        return xStreamBufferReceive(handle, buffer.data(), buffer.size(), portMAX_DELAY);
+    }
+
+    //! @return Number of bytes read; when timeout occurred, the bytes available are read, even below the trigger level.
+    std::size_t receive(std::span<std::byte> buffer, unsigned timeout_ms)
+    {
+        return xStreamBufferReceive(handle, buffer.data(), buffer.size(), pdMS_TO_TICKS(timeout_ms));
+    }
+
+    //! Call from ISR context only. @return Number of bytes read.
+    std::size_t receive_from_isr(std::span<std::byte> buffer)
+    {
+        BaseType_t higher_priority_task_woken{pdFALSE};
+        auto r{xStreamBufferReceiveFromISR(handle, buffer.data(), buffer.size(), &higher_priority_task_woken)};
+        portYIELD_FROM_ISR(higher_priority_task_woken);
+        return r;
+    }
+
+    //! @return false when the trigger level is bigger than the capacity.
+    bool set_trigger_level(std::size_t trigger_level)
+    {
+        return xStreamBufferSetTriggerLevel(handle, trigger_level) == pdTRUE;
+    }
+
+    std::size_t bytes_available() const
+    {
+        return xStreamBufferBytesAvailable(handle);
+    }
+
+    std::size_t space_available() const
+    {
+        return xStreamBufferSpacesAvailable(handle);
+    }
+
+    //! Drops all the bytes. Succeeds only when no task is blocked on the buffer.
+    bool reset()
+    {
+        return xStreamBufferReset(handle) == pdPASS;
+    }
+
+  private:
+    // FreeRTOS requires one byte more than the capacity.
+    std::uint8_t storage[Capacity + 1];
+    StaticStreamBuffer_t stream_buffer_storage;
+    StreamBufferHandle_t handle;
+};
+
+} // namespace freertos
+
+} // namespace jungles
+
+#endif /* FREERTOS_STREAM_BUFFER_HPP */
@@ -7,16 +7,18 @@
 #define FREERTOS_THREAD_IMPL_HPP
 
 #include "FreeRTOS.h"
-#include "semphr.h"
 #include "task.h"
 
-#include <array>
 #include <cassert>
+#include <exception>
 #include <functional>
 #include <memory>
 #include <string>
 #include <string_view>
 
+#include "jungles_os_helpers/freertos/thread_stats.hpp"
+#include "jungles_os_helpers/utils/error.hpp"
+
 namespace jungles
 {
 
@@ -29,7 +31,7 @@ class thread
     using ThreadCode = std::function<void(void)>;
 
     thread(std::string name, unsigned stack_size, int priority) :
-        thread_owner_shared_pointer{std::make_shared<thread_owner>(std::move(name), stack_size, priority)}
+        block{std::make_unique<control_block>(std::move(name), stack_size, priority)}
     {
     }
 
@@ -41,33 +43,103 @@ class thread
     void start(ThreadCode thread_code)
     {
         is_started = true;
-        thread_owner_shared_pointer->start(std::move(thread_code));
+        block->thread_code = std::move(thread_code);
+        auto result{xTaskCreate(task_fun, block->name.c_str(), block->stack_size, block.get(), block->priority, &handle)};
+        assert(result == pdPASS);
+        (void) result;
     }
 
-    void join()
+    enum class status
+    {
+        ok,
+        already_detached,
+        already_joined,
+        not_started
+    };
+
+    /**
+     * @brief Waits until the thread code finishes.
+     *
+     * Blocks on the notification value (index 0) of the joining task, which the finishing task notifies. That
+     * notification is always consumed before join() returns. A notification given meanwhile to another user of the
+     * value may be consumed too; the queues and the event groups of this library check their state after each
+     * wake-up, so they tolerate it.
+     *
+     * @return In the exception-free mode the error; otherwise the corresponding exception is thrown.
+     */
+    status join()
     {
         if (is_detached)
-            throw already_detached_error{};
+            return utils::report_error<already_detached_error>(status::already_detached);
         else if (is_joined)
-            return;
+            return status::ok;
         else if (!is_started)
-            throw not_started_error{};
-
-        thread_owner_shared_pointer->wait_task_finished();
+            return utils::report_error<not_started_error>(status::not_started);
+
+        taskENTER_CRITICAL();
+        auto is_finished{block->state == control_block::task_state::finished};
+        if (!is_finished)
+            block->joiner = xTaskGetCurrentTaskHandle();
+        taskEXIT_CRITICAL();
+
+        // The notification value may be shared with other users of ulTaskNotifyTake() running on the joining task,
+        // so the state is checked again after each wake-up. The task notifies the registered joiner within the same
+        // critical section in which it finishes, so once the task is seen finished, the notification has been given.
+        // It is consumed then, even if the last wake-up was caused by another user, so that it doesn't wake up the
+        // joining task later on.
+        if (!is_finished)
+        {
+            do
+            {
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+                taskENTER_CRITICAL();
+                is_finished = block->state == control_block::task_state::finished;
+                taskEXIT_CRITICAL();
+            } while (!is_finished);
+            ulTaskNotifyTake(pdTRUE, 0);
+        }
 
         is_joined = true;
+        return status::ok;
     }
 
-    void detach()
+    //! In the exception-free mode the error is returned, otherwise the corresponding exception is thrown.
+    status detach()
     {
         if (is_detached)
-            throw already_detached_error{};
+            return utils::report_error<already_detached_error>(status::already_detached);
         else if (is_joined)
-            throw already_joined_error{};
+            return utils::report_error<already_joined_error>(status::already_joined);
         else if (!is_started)
-            throw not_started_error{};
+            return utils::report_error<not_started_error>(status::not_started);
+
+        taskENTER_CRITICAL();
+        auto is_finished{block->state == control_block::task_state::finished};
+        if (!is_finished)
+            block->state = control_block::task_state::detached;
+        taskEXIT_CRITICAL();
+
+        // From now on the task owns the control block, unless it has already finished.
+        if (!is_finished)
+            block.release();
 
         is_detached = true;
+        return status::ok;
+    }
+
+    //! Samples the statistics of the task; the CPU share is computed since the previous call.
+    thread_stats stats()
+    {
+        if (!is_started or is_detached)
+            return {};
+
+        // With the scheduler suspended, the task can't get deleted after it is seen as unfinished.
+        thread_stats s{.state = eDeleted};
+        vTaskSuspendAll();
+        if (block->state != control_block::task_state::finished)
+            s = sampler.sample(handle);
+        xTaskResumeAll();
+        return s;
     }
 
     ~thread()
@@ -94,81 +166,53 @@ class thread
     };
 
   private:
-    struct thread_owner : public std::enable_shared_from_this<thread_owner>
+    //! Shared by the thread object and the task. The ownership is decided by the state, which is accessed only
+    //! within a critical section: the task deletes the block when it finishes after being detached.
+    struct control_block
     {
-        explicit thread_owner(std::string&& name, unsigned stack_size, int priority) :
-            task_finished_sem{xSemaphoreCreateBinaryStatic(&task_finished_sem_storage)},
-            name{std::move(name)},
-            stack_size{stack_size},
-            priority{priority}
+        control_block(std::string&& name, unsigned stack_size, int priority) :
+            name{std::move(name)}, stack_size{stack_size}, priority{priority}
         {
-            assert(task_finished_sem != nullptr);
         }
 
-        void start(ThreadCode&& thread_code)
+        enum class task_state
         {
-            this->thread_code = std::move(thread_code);
-            shared_ptr_to_myself = shared_from_this();
-            auto result{xTaskCreate(task_fun,
-                                    name.c_str(),
-                                    stack_size,
-                                    shared_ptr_to_myself.get(), // Forward self to the task code.
-                                    priority,
-                                    nullptr)};
-            assert(result == pdPASS);
-            (void) result;
-        }
+            running,
+            finished,
+            detached
+        };
 
-        void notify_task_finished()
-        {
-            xSemaphoreGive(task_finished_sem);
-        }
-
-        void wait_task_finished()
-        {
-            xSemaphoreTake(task_finished_sem, portMAX_DELAY);
-        }
-
-        ~thread_owner()
-        {
-            vSemaphoreDelete(task_finished_sem);
-        }
-
-        static inline void task_fun(void* raw_pointer_to_thread_owner)
-        {
-            auto with_shared_pointer_to_thread_owner_being_self_destructed_before_call_to_vTaskDelete{
-                [=](std::function<void(std::shared_ptr<thread_owner> &&)> handler) {
-                    auto self{static_cast<thread_owner*>(raw_pointer_to_thread_owner)->shared_ptr_to_myself};
-                    handler(std::move(self));
-                }};
-
-            with_shared_pointer_to_thread_owner_being_self_destructed_before_call_to_vTaskDelete([](auto&& self) {
-                auto remove_cyclic_reference_to_self{[](auto& self) {
-                    self->shared_ptr_to_myself = nullptr;
-                }};
-
-                auto run_users_thread_code{[](auto& self) {
-                    self->thread_code();
-                }};
-
-                remove_cyclic_reference_to_self(self);
-                run_users_thread_code(self);
-                self->notify_task_finished();
-            });
-
-            vTaskDelete(nullptr);
-        }
-
-        StaticSemaphore_t task_finished_sem_storage = {};
-        SemaphoreHandle_t task_finished_sem = {};
-        std::shared_ptr<thread_owner> shared_ptr_to_myself;
         std::string name;
         unsigned stack_size;
         int priority;
         ThreadCode thread_code;
+        TaskHandle_t joiner{nullptr};
+        task_state state{task_state::running};
     };
 
-    std::shared_ptr<thread_owner> thread_owner_shared_pointer;
+    static inline void task_fun(void* raw_pointer_to_control_block)
+    {
+        auto block{static_cast<control_block*>(raw_pointer_to_control_block)};
+        block->thread_code();
+
+        // The joiner is notified within the critical section, see join().
+        taskENTER_CRITICAL();
+        auto is_detached{block->state == control_block::task_state::detached};
+        block->state = control_block::task_state::finished;
+        if (block->joiner != nullptr)
+            xTaskNotifyGive(block->joiner);
+        taskEXIT_CRITICAL();
+
+        // The block must not be touched after it is marked as finished, unless the task owns it.
+        if (is_detached)
+            delete block;
+
+        vTaskDelete(nullptr);
+    }
+
+    std::unique_ptr<control_block> block;
+    TaskHandle_t handle{nullptr};
+    detail::thread_stats_sampler sampler;
     bool is_detached{false};
     bool is_joined{false};
     bool is_started{false};
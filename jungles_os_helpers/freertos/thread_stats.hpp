@@ -0,0 +1,102 @@
+/**
+ * @file	thread_stats.hpp
+ * @brief	Statistics of a FreeRTOS task, used to size the stacks and find the CPU hogs.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef FREERTOS_THREAD_STATS_HPP
+#define FREERTOS_THREAD_STATS_HPP
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <cstdint>
+
+namespace jungles
+{
+
+namespace freertos
+{
+
+/**
+ * @brief Statistics of a task.
+ *
+ * The stack high-water mark needs INCLUDE_uxTaskGetStackHighWaterMark and the state needs INCLUDE_eTaskGetState.
+ * The runtime and the CPU share are available only when configUSE_TRACE_FACILITY and configGENERATE_RUN_TIME_STATS
+ * are set, otherwise they are always zero.
+ */
+struct thread_stats
+{
+    //! The minimum amount of free stack space there has been since the task started, in words.
+    std::size_t stack_high_water_mark{0};
+
+    //! Accumulated runtime, in the units of the run time stats counter.
+    std::uint64_t runtime{0};
+
+    //! CPU share since the previous sample, in permille of the total runtime.
+    unsigned cpu_share_permille{0};
+
+    //! eInvalid when the thread is not started or detached, eDeleted when the thread code has finished.
+    eTaskState state{eInvalid};
+};
+
+namespace detail
+{
+
+//! Remembers the previous sample, to compute the CPU share between two consecutive samples.
+class thread_stats_sampler
+{
+  public:
+    //! The task must exist while it is sampled.
+    thread_stats sample(TaskHandle_t handle)
+    {
+        thread_stats s;
+        s.state = eTaskGetState(handle);
+        if (s.state == eDeleted)
+            return s;
+
+        s.stack_high_water_mark = uxTaskGetStackHighWaterMark(handle);
+
+#if (configUSE_TRACE_FACILITY == 1) && (configGENERATE_RUN_TIME_STATS == 1)
+        TaskStatus_t status;
+        vTaskGetInfo(handle, &status, pdFALSE, s.state);
+        auto total_runtime{get_total_runtime()};
+
+        s.runtime = status.ulRunTimeCounter;
+        auto runtime_delta{static_cast<std::uint64_t>(status.ulRunTimeCounter - last_runtime)};
+        auto total_runtime_delta{static_cast<std::uint64_t>(total_runtime - last_total_runtime)};
+        if (total_runtime_delta != 0)
+            s.cpu_share_permille = static_cast<unsigned>(runtime_delta * 1000 / total_runtime_delta);
+
+        last_runtime = status.ulRunTimeCounter;
+        last_total_runtime = total_runtime;
+#endif
+
+        return s;
+    }
+
+  private:
+#if (configUSE_TRACE_FACILITY == 1) && (configGENERATE_RUN_TIME_STATS == 1)
+    using Counter = decltype(TaskStatus_t::ulRunTimeCounter);
+
+    static Counter get_total_runtime()
+    {
+#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+        Counter r;
+        portALT_GET_RUN_TIME_COUNTER_VALUE(r);
+        return r;
+#else
+        return portGET_RUN_TIME_COUNTER_VALUE();
+#endif
+    }
+
+    Counter last_runtime{0};
+    Counter last_total_runtime{0};
+#endif
+};
+
+} // namespace detail
+
+} // namespace freertos
+} // namespace jungles
+
+#endif /* FREERTOS_THREAD_STATS_HPP */
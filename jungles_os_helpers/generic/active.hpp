@@ -9,6 +9,8 @@
 #include <functional>
 #include <variant>
 
+#include "jungles_os_helpers/generic/blocking_send.hpp"
+
 namespace jungles
 {
 
@@ -41,14 +43,16 @@ class active
         thread_impl.start([this]() { this->thread_code(); });
     }
 
-    void send(Message&& m)
+    //! Returns whatever the message pump returns on send, e.g. an error code in the exception-free mode.
+    auto send(Message&& m)
     {
-        message_pump_impl.send({std::move(m)});
+        return message_pump_impl.send({std::move(m)});
     }
 
+    //! Waits for space in the pump for the quit message, so that the thread is always joined.
     ~active()
     {
-        message_pump_impl.send(quit_message{});
+        send_blocking(message_pump_impl, MessageProxy{quit_message{}});
         thread_impl.join();
     }
 
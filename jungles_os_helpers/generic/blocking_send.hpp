@@ -0,0 +1,46 @@
+/**
+ * @file        blocking_send.hpp
+ * @brief       Sends a message which mustn't be lost, e.g. a quit message, even when the pump is full at the moment.
+ */
+#ifndef GENERIC_BLOCKING_SEND_HPP
+#define GENERIC_BLOCKING_SEND_HPP
+
+#include <concepts>
+#include <utility>
+
+namespace jungles
+{
+
+namespace generic
+{
+
+/**
+ * @brief Waits until the message fits in the pump, instead of reporting that the pump is full.
+ *
+ * Uses the timed send, in a loop, of the pumps which have one, e.g. jungles::freertos::queue, since their plain send()
+ * throws, or returns false in the exception-free mode, when the pump is full. The message isn't moved when the timed
+ * send fails. The other pumps are expected to block, or to be unbounded, on the plain send().
+ */
+template<typename MessagePump, typename Message>
+void send_blocking(MessagePump& pump, Message&& m)
+{
+    if constexpr (requires {
+                      {
+                          pump.send(std::move(m), 0u)
+                      } -> std::convertible_to<bool>;
+                  })
+    {
+        constexpr unsigned retry_period_ms{1000};
+        while (!pump.send(std::move(m), retry_period_ms))
+        {
+        }
+    } else
+    {
+        pump.send(std::move(m));
+    }
+}
+
+} // namespace generic
+} // namespace jungles
+
+#endif /* GENERIC_BLOCKING_SEND_HPP */
@@ -0,0 +1,58 @@
+/**
+ * @file        select_order.hpp
+ * @brief       Decides which of the ready message pumps shall be served first by a selector.
+ * @author      Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef SELECT_ORDER_HPP
+#define SELECT_ORDER_HPP
+
+#include <array>
+#include <cstddef>
+#include <optional>
+
+namespace jungles
+{
+namespace generic
+{
+
+enum class select_order
+{
+    //! The pump passed first to the selector wins, when multiple pumps are ready.
+    priority,
+    //! The search for a ready pump starts after the pump returned lately, so that no pump is starved.
+    round_robin
+};
+
+template<std::size_t N>
+class ready_picker
+{
+  public:
+    explicit ready_picker(select_order order) : order{order}
+    {
+    }
+
+    //! @return Index of the pump to be served, or std::nullopt when no pump is ready.
+    std::optional<std::size_t> pick(const std::array<bool, N>& is_ready)
+    {
+        auto start{order == select_order::round_robin ? next_start : 0};
+        for (std::size_t i{0}; i < N; ++i)
+        {
+            auto idx{(start + i) % N};
+            if (is_ready[idx])
+            {
+                next_start = (idx + 1) % N;
+                return idx;
+            }
+        }
+        return std::nullopt;
+    }
+
+  private:
+    select_order order;
+    std::size_t next_start{0};
+};
+
+} // namespace generic
+} // namespace jungles
+
+#endif /* SELECT_ORDER_HPP */
@@ -8,6 +8,9 @@
 #include <array>
 #include <functional>
 #include <mutex>
+#include <type_traits>
+
+#include "jungles_os_helpers/generic/blocking_send.hpp"
 
 namespace os::generic
 {
@@ -44,28 +47,52 @@ struct thread_pool
         }
     }
 
+    /**
+     * Waits for space in the queues for the tasks which stop the runners, so that the runners are always joined. The
+     * mutex is not taken meanwhile: a task which calls execute() must not block the runner which would make the space.
+     */
     ~thread_pool()
     {
         for (unsigned i = 0; i < runners_count; ++i)
-        {
-            std::lock_guard g{mux};
-            pumps[i].send([&done = this->dones[i]]() { done = true; });
-        }
+            jungles::generic::send_blocking(pumps[i], Task{[&done = this->dones[i]]() { done = true; }});
 
         for (unsigned i = 0; i < runners_count; ++i)
             runners[i].join();
     }
 
-    void execute(Task task)
+    //! Returns whatever the queue returns on send, e.g. an error code in the exception-free mode. The next runner is
+    //! picked only when the task is accepted.
+    auto execute(Task task)
     {
         std::lock_guard g{mux};
-        pumps[current_runner_idx].send(std::move(task));
-        current_runner_idx = (current_runner_idx + 1) % runners_count;
+        auto& pump{pumps[current_runner_idx]};
+        if constexpr (std::is_void_v<decltype(pump.send(std::move(task)))>)
+        {
+            pump.send(std::move(task));
+            pick_next_runner();
+        } else
+        {
+            auto result{pump.send(std::move(task))};
+            if (result)
+                pick_next_runner();
+            return result;
+        }
+    }
+
+    //! Gives access to the runners, e.g. to sample their statistics. Shall not be started, joined nor detached.
+    Thread& runner(unsigned idx)
+    {
+        return runners[idx];
     }
 
   private:
     using MessagePump = Queue<Task>;
 
+    void pick_next_runner()
+    {
+        current_runner_idx = (current_runner_idx + 1) % runners_count;
+    }
+
     std::array<Thread, runners_count> runners;
     std::array<MessagePump, runners_count> pumps;
     std::array<bool, runners_count> dones = {};
@@ -16,14 +16,18 @@ namespace jungles
 namespace native
 {
 
-template<typename Message>
+/**
+ * \tparam Message Type of message to be passed around.
+ * \tparam WaitStrategy Policy from jungles::native::wait_strategy, used by the underlying message pump.
+ */
+template<typename Message, typename WaitStrategy = wait_strategy::park>
 class active
 {
   private:
     using Thread = jungles::native::thread;
 
     template<typename T>
-    using MessagePumpTemplate = jungles::native::message_pump<T>;
+    using MessagePumpTemplate = jungles::native::message_pump<T, WaitStrategy>;
 
     using Active = jungles::generic::active<Message, MessagePumpTemplate, Thread>;
     using MessagePump = typename Active::MessagePump;
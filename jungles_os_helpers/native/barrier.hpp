@@ -0,0 +1,83 @@
+/**
+ * @file        barrier.hpp
+ * @brief       Rendezvous barrier for the native platform, with the same interface as the FreeRTOS one.
+ */
+#ifndef NATIVE_BARRIER_HPP
+#define NATIVE_BARRIER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "jungles_os_helpers/native/eventcount.hpp"
+#include "jungles_os_helpers/utils/enum_to_bits.hpp"
+
+namespace jungles::native
+{
+
+/**
+ * @brief Each of the participants sets its own bit and blocks until all the participants have arrived.
+ *
+ * The participant which completes the set clears the bits and bumps the generation in a single step, so the barrier
+ * is reused for the next cycle right away, and the other participants wait for the generation to change.
+ */
+template<auto... Participants>
+class barrier
+{
+  private:
+    using Bits = std::uint64_t;
+    using EnumToBits = utils::EnumToBits<Bits, Participants...>;
+
+  public:
+    template<auto Participant>
+    void arrive_and_wait()
+    {
+        constexpr auto bit{EnumToBits::template to_bits<Participant>()};
+        auto arrival_generation{arrive(bit)};
+        waiters.wait([&]() { return generation.load(std::memory_order_acquire) != arrival_generation; });
+    }
+
+    //! @return false on timeout, in which case the participant remains arrived in the current cycle.
+    template<auto Participant>
+    bool arrive_and_wait(std::chrono::milliseconds timeout)
+    {
+        constexpr auto bit{EnumToBits::template to_bits<Participant>()};
+        auto deadline{std::chrono::steady_clock::now() + timeout};
+        auto arrival_generation{arrive(bit)};
+        return waiters.wait_until(
+            [&]() { return generation.load(std::memory_order_acquire) != arrival_generation; }, deadline);
+    }
+
+  private:
+    //! @return The generation of the cycle the participant has arrived in.
+    std::uint32_t arrive(Bits bit)
+    {
+        // Read before arriving: the cycle can't complete without this participant, so it can't be missed.
+        auto arrival_generation{generation.load(std::memory_order_acquire)};
+        auto current{arrived.load(std::memory_order_relaxed)};
+        while (true)
+        {
+            auto is_last{(current | bit) == all_bits};
+            if (arrived.compare_exchange_weak(
+                    current, is_last ? 0 : current | bit, std::memory_order_acq_rel, std::memory_order_relaxed))
+            {
+                if (is_last)
+                {
+                    generation.fetch_add(1, std::memory_order_release);
+                    waiters.notify_all();
+                }
+                return arrival_generation;
+            }
+        }
+    }
+
+    static inline constexpr auto all_bits{EnumToBits::template to_bits<Participants...>()};
+
+    std::atomic<Bits> arrived{0};
+    std::atomic<std::uint32_t> generation{0};
+    eventcount waiters;
+};
+
+} // namespace jungles::native
+
+#endif /* NATIVE_BARRIER_HPP */
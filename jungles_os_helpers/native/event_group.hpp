@@ -0,0 +1,166 @@
+/**
+ * @file        event_group.hpp
+ * @brief       Event group for the native platform, with the same interface as the FreeRTOS one.
+ */
+#ifndef NATIVE_EVENT_GROUP_HPP
+#define NATIVE_EVENT_GROUP_HPP
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+#include "jungles_os_helpers/native/eventcount.hpp"
+#include "jungles_os_helpers/utils/enum_to_bits.hpp"
+#include "jungles_os_helpers/utils/event_set.hpp"
+
+namespace jungles::native
+{
+
+using Bits = std::uint64_t;
+
+/**
+ * @brief Event group backed by a single atomic word, supporting up to 64 events.
+ *
+ * Setting and clearing the events is a single atomic read-modify-write; set() additionally wakes the waiters, but
+ * only when there are any. A wait consumes the events it returns atomically, so multiple consumers may wait for
+ * the same events and each set event is received once.
+ */
+template<auto... Events>
+class event_group
+{
+  private:
+    using EnumToBits = utils::EnumToBits<Bits, Events...>;
+    using EnumType = typename EnumToBits::value_type;
+
+  public:
+    using EventSet = utils::event_set<EnumType, Bits>;
+
+    static_assert(sizeof...(Events) <= sizeof(Bits) * 8, "Too many events for the underlying event group");
+
+    template<auto... Evts>
+    void set()
+    {
+        constexpr auto bits{EnumToBits::template to_bits<Evts...>()};
+        events.fetch_or(bits, std::memory_order_release);
+        waiters.notify_all();
+    }
+
+    Bits get() const
+    {
+        return events.load(std::memory_order_acquire);
+    }
+
+    template<auto... Evts>
+    void clear()
+    {
+        constexpr auto bits{EnumToBits::template to_bits<Evts...>()};
+        events.fetch_and(~bits, std::memory_order_relaxed);
+    }
+
+    //! Waits for any of the events and clears the received one.
+    template<auto... Evts>
+    EnumType wait_one()
+    {
+        constexpr auto bits{EnumToBits::template to_bits<Evts...>()};
+        Bits event_bit{0};
+        waiters.wait([&]() { return (event_bit = take_one(bits)) != 0; });
+        return to_enum(event_bit);
+    }
+
+    template<auto... Evts>
+    std::optional<EnumType> wait_one(std::chrono::milliseconds timeout)
+    {
+        constexpr auto bits{EnumToBits::template to_bits<Evts...>()};
+        Bits event_bit{0};
+        auto deadline{std::chrono::steady_clock::now() + timeout};
+        if (waiters.wait_until([&]() { return (event_bit = take_one(bits)) != 0; }, deadline))
+            return to_enum(event_bit);
+        return std::nullopt;
+    }
+
+    //! Waits for any of the events and returns all the awaited events which are set, clearing them atomically.
+    template<auto... Evts>
+    EventSet wait_any()
+    {
+        constexpr auto bits{EnumToBits::template to_bits<Evts...>()};
+        Bits taken{0};
+        waiters.wait([&]() { return (taken = take_any(bits)) != 0; });
+        return EventSet{taken};
+    }
+
+    //! Returns an empty set on timeout.
+    template<auto... Evts>
+    EventSet wait_any(std::chrono::milliseconds timeout)
+    {
+        constexpr auto bits{EnumToBits::template to_bits<Evts...>()};
+        Bits taken{0};
+        auto deadline{std::chrono::steady_clock::now() + timeout};
+        waiters.wait_until([&]() { return (taken = take_any(bits)) != 0; }, deadline);
+        return EventSet{taken};
+    }
+
+    //! Waits until all the events are set and clears them.
+    template<auto... Evts>
+    void wait_all()
+    {
+        constexpr auto bits{EnumToBits::template to_bits<Evts...>()};
+        waiters.wait([&]() { return take_all(bits); });
+    }
+
+    //! @return false on timeout, in which case none of the events is cleared.
+    template<auto... Evts>
+    bool wait_all(std::chrono::milliseconds timeout)
+    {
+        constexpr auto bits{EnumToBits::template to_bits<Evts...>()};
+        auto deadline{std::chrono::steady_clock::now() + timeout};
+        return waiters.wait_until([&]() { return take_all(bits); }, deadline);
+    }
+
+  private:
+    //! @return The lowest of the awaited bits which was set and has been cleared, or 0 if none is set.
+    Bits take_one(Bits awaited)
+    {
+        auto current{events.load(std::memory_order_relaxed)};
+        while (true)
+        {
+            auto matching{current & awaited};
+            if (matching == 0)
+                return 0;
+            auto lowest{matching & -matching};
+            if (events.compare_exchange_weak(
+                    current, current & ~lowest, std::memory_order_acquire, std::memory_order_relaxed))
+                return lowest;
+        }
+    }
+
+    Bits take_any(Bits awaited)
+    {
+        return events.fetch_and(~awaited, std::memory_order_acquire) & awaited;
+    }
+
+    bool take_all(Bits awaited)
+    {
+        auto current{events.load(std::memory_order_relaxed)};
+        while ((current & awaited) == awaited)
+        {
+            if (events.compare_exchange_weak(
+                    current, current & ~awaited, std::memory_order_acquire, std::memory_order_relaxed))
+                return true;
+        }
+        return false;
+    }
+
+    static EnumType to_enum(Bits event_bit)
+    {
+        return static_cast<EnumType>(std::countr_zero(event_bit));
+    }
+
+    std::atomic<Bits> events{0};
+    eventcount waiters;
+};
+
+} // namespace jungles::native
+
+#endif /* NATIVE_EVENT_GROUP_HPP */
@@ -0,0 +1,215 @@
+/**
+ * @file	eventcount.hpp
+ * @brief	Eventcount: lets threads wait on a lock-free condition, without a syscall on the notifying side when no one
+ *          waits.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef JUNGLES_NATIVE_EVENTCOUNT_HPP
+#define JUNGLES_NATIVE_EVENTCOUNT_HPP
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace jungles::native
+{
+
+/**
+ * @brief Parking primitive for conditions which are checked without a lock.
+ *
+ * The waiter announces itself with prepare_wait(), re-checks the condition and then either calls cancel_wait() (the
+ * condition became true) or commit_wait() (sleeps until the next notification). The notifier first makes the
+ * condition true and then calls notify_one() / notify_all(). When no one is waiting notifying costs a fence and a
+ * load; otherwise exactly the requested number of sleepers is woken up.
+ *
+ * On Linux the sleeping is done with a futex on the epoch word. On other systems a mutex and a condition variable are
+ * used for that, but only when there is a waiter.
+ *
+ * \tparam ProcessShared When true, the eventcount may be placed in memory shared between processes (Linux only).
+ */
+template<bool ProcessShared = false>
+class basic_eventcount
+{
+  public:
+    using key = std::uint32_t;
+
+    basic_eventcount() = default;
+    basic_eventcount(const basic_eventcount&) = delete;
+    basic_eventcount& operator=(const basic_eventcount&) = delete;
+    basic_eventcount(basic_eventcount&&) = delete;
+    basic_eventcount& operator=(basic_eventcount&&) = delete;
+
+    key prepare_wait()
+    {
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+        // Pairs with the fence in notify(): either the notifier sees us waiting, or we see the condition fulfilled.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return epoch.load(std::memory_order_acquire);
+    }
+
+    void cancel_wait()
+    {
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void commit_wait(key k)
+    {
+        while (epoch.load(std::memory_order_acquire) == k)
+            park(k, nullptr);
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    //! @return false when the deadline passed and no notification came.
+    template<class Clock, class Duration>
+    bool commit_wait_until(key k, const std::chrono::time_point<Clock, Duration>& deadline)
+    {
+        bool is_notified{true};
+        while (epoch.load(std::memory_order_acquire) == k)
+        {
+            auto now{Clock::now()};
+            if (now >= deadline)
+            {
+                is_notified = false;
+                break;
+            }
+            auto remaining{std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now)};
+            park(k, &remaining);
+        }
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+        return is_notified;
+    }
+
+    //! Blocks until the predicate becomes true. The predicate is called without any lock taken.
+    template<typename Predicate>
+    void wait(Predicate&& is_ready)
+    {
+        while (!is_ready())
+        {
+            auto k{prepare_wait()};
+            if (is_ready())
+            {
+                cancel_wait();
+                return;
+            }
+            commit_wait(k);
+        }
+    }
+
+    //! @return Value of the predicate when the function returns.
+    template<typename Predicate, class Clock, class Duration>
+    bool wait_until(Predicate&& is_ready, const std::chrono::time_point<Clock, Duration>& deadline)
+    {
+        while (!is_ready())
+        {
+            auto k{prepare_wait()};
+            if (is_ready())
+            {
+                cancel_wait();
+                return true;
+            }
+            if (!commit_wait_until(k, deadline))
+                return is_ready();
+        }
+        return true;
+    }
+
+    void notify_one()
+    {
+        notify(1);
+    }
+
+    void notify_all()
+    {
+        notify(INT_MAX);
+    }
+
+    void notify(int count)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) == 0)
+            return;
+
+        wake(count);
+    }
+
+  private:
+#if defined(__linux__)
+    static_assert(sizeof(std::atomic<key>) == sizeof(key) and std::atomic<key>::is_always_lock_free,
+                  "The epoch must be usable as a futex word");
+
+    static constexpr int futex_wait_op{ProcessShared ? FUTEX_WAIT : FUTEX_WAIT_PRIVATE};
+    static constexpr int futex_wake_op{ProcessShared ? FUTEX_WAKE : FUTEX_WAKE_PRIVATE};
+
+    void park(key k, const std::chrono::nanoseconds* timeout)
+    {
+        timespec ts{};
+        if (timeout != nullptr)
+        {
+            ts.tv_sec = timeout->count() / 1'000'000'000;
+            ts.tv_nsec = timeout->count() % 1'000'000'000;
+        }
+        syscall(SYS_futex,
+                reinterpret_cast<key*>(&epoch),
+                futex_wait_op,
+                k,
+                timeout != nullptr ? &ts : nullptr,
+                nullptr,
+                0);
+    }
+
+    void wake(int count)
+    {
+        epoch.fetch_add(1, std::memory_order_release);
+        syscall(SYS_futex, reinterpret_cast<key*>(&epoch), futex_wake_op, count, nullptr, nullptr, 0);
+    }
+#else
+    static_assert(!ProcessShared, "Process-shared eventcount is supported on Linux only");
+
+    void park(key k, const std::chrono::nanoseconds* timeout)
+    {
+        std::unique_lock lk{mux};
+        auto is_notified{[&]() {
+            return epoch.load(std::memory_order_acquire) != k;
+        }};
+        if (timeout != nullptr)
+            cv.wait_for(lk, *timeout, is_notified);
+        else
+            cv.wait(lk, is_notified);
+    }
+
+    void wake(int count)
+    {
+        {
+            std::lock_guard g{mux};
+            epoch.fetch_add(1, std::memory_order_release);
+        }
+        if (count == 1)
+            cv.notify_one();
+        else
+            cv.notify_all();
+    }
+
+    std::mutex mux;
+    std::condition_variable cv;
+#endif
+
+    std::atomic<key> epoch{0};
+    std::atomic<std::uint32_t> waiters{0};
+};
+
+using eventcount = basic_eventcount<>;
+
+} // namespace jungles::native
+
+#endif /* JUNGLES_NATIVE_EVENTCOUNT_HPP */
@@ -0,0 +1,150 @@
+/**
+ * @file	eventfd_message_pump.hpp
+ * @brief	Message pump which can be waited on by an epoll / io_uring event loop, through an eventfd (Linux only).
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef NATIVE_EVENTFD_MESSAGE_PUMP_HPP
+#define NATIVE_EVENTFD_MESSAGE_PUMP_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <ranges>
+#include <system_error>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace jungles::native
+{
+
+/**
+ * @brief Message pump exposing a pollable file descriptor.
+ *
+ * The eventfd is readable exactly when the pump has messages: it is signalled on the empty-to-non-empty transition
+ * and reset when the pump is drained, both under the pump's lock. An event loop shall wait for the descriptor to be
+ * readable (level-triggered) and then call receive_many_immediate(), which doesn't block. Sending to a non-empty pump
+ * doesn't touch the descriptor at all, so a burst of messages costs the loop a single wake-up.
+ */
+template<typename Message>
+class eventfd_message_pump
+{
+  public:
+    eventfd_message_pump() : efd{eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)}
+    {
+        if (efd == -1)
+            throw std::system_error{errno, std::generic_category()};
+    }
+
+    eventfd_message_pump(const eventfd_message_pump&) = delete;
+    eventfd_message_pump& operator=(const eventfd_message_pump&) = delete;
+    eventfd_message_pump(eventfd_message_pump&&) = delete;
+    eventfd_message_pump& operator=(eventfd_message_pump&&) = delete;
+
+    ~eventfd_message_pump()
+    {
+        close(efd);
+    }
+
+    //! Readable when the pump has messages. Must not be read from or written to by the user.
+    int native_handle() const
+    {
+        return efd;
+    }
+
+    void send(Message&& m)
+    {
+        std::lock_guard g{mux};
+        queue.push(std::move(m));
+        if (queue.size() == 1)
+            signal();
+    }
+
+    //! Sends all the messages from the range under a single lock and with a single signal. The messages are moved out
+    //! of the range.
+    template<std::ranges::input_range Range>
+    void send_many(Range&& messages)
+    {
+        std::lock_guard g{mux};
+        auto was_empty{queue.empty()};
+        for (auto&& m : messages)
+            queue.push(std::move(m));
+        if (was_empty and !queue.empty())
+            signal();
+    }
+
+    Message receive()
+    {
+        while (true)
+        {
+            if (auto m{receive_immediate()})
+                return std::move(*m);
+            wait_readable();
+        }
+    }
+
+    std::optional<Message> receive_immediate()
+    {
+        std::lock_guard g{mux};
+        if (queue.empty())
+            return std::nullopt;
+        return pop();
+    }
+
+    /**
+     * @brief Receives up to max messages under a single lock, without blocking.
+     * @return Number of messages written to the output iterator.
+     */
+    template<std::output_iterator<Message> OutputIt>
+    std::size_t receive_many_immediate(OutputIt out, std::size_t max)
+    {
+        std::lock_guard g{mux};
+        std::size_t count{0};
+        for (; count < max and !queue.empty(); ++count)
+            *out++ = pop();
+        return count;
+    }
+
+  private:
+    //! Call only if it is certain that the queue is not empty, and the mux must be taken while calling this function.
+    Message pop()
+    {
+        auto r{std::move(queue.front())};
+        queue.pop();
+        if (queue.empty())
+            reset();
+        return r;
+    }
+
+    void signal()
+    {
+        std::uint64_t one{1};
+        [[maybe_unused]] auto r{write(efd, &one, sizeof(one))};
+    }
+
+    void reset()
+    {
+        std::uint64_t counter;
+        [[maybe_unused]] auto r{read(efd, &counter, sizeof(counter))};
+    }
+
+    void wait_readable()
+    {
+        pollfd pfd{.fd = efd, .events = POLLIN, .revents = 0};
+        while (poll(&pfd, 1, -1) == -1 and errno == EINTR)
+            ;
+    }
+
+    int efd;
+    std::mutex mux;
+    std::queue<Message> queue;
+};
+
+} // namespace jungles::native
+
+#endif /* NATIVE_EVENTFD_MESSAGE_PUMP_HPP */
@@ -6,48 +6,97 @@
 #ifndef FLAG_HPP
 #define FLAG_HPP
 
+#include <atomic>
 #include <chrono>
-#include <condition_variable>
-#include <mutex>
+
+#include "jungles_os_helpers/native/eventcount.hpp"
+#include "jungles_os_helpers/native/wait_strategy.hpp"
 
 namespace jungles
 {
 
-class flag
+/**
+ * @brief Settable, resettable and waitable flag.
+ *
+ * is_set() is a single load, and set() is a store followed by a check of the waiter count, so it doesn't enter
+ * the kernel when nobody waits.
+ *
+ * \tparam WaitStrategy Policy from jungles::native::wait_strategy, applied by the waits before parking.
+ * \tparam AutoReset When true, a successful wait consumes the flag, so each set() releases a single waiter.
+ */
+template<typename WaitStrategy = native::wait_strategy::park, bool AutoReset = false>
+class basic_flag
 {
   public:
     void set()
     {
-        std::lock_guard g{mux};
-        flag = true;
-        cv.notify_all();
+        flag.store(true, std::memory_order_release);
+        if constexpr (AutoReset)
+            waiters.notify_one();
+        else
+            waiters.notify_all();
+    }
+
+    void reset()
+    {
+        flag.store(false, std::memory_order_relaxed);
     }
 
     void wait()
     {
-        std::unique_lock lk{mux};
-        cv.wait(lk, [this]() { return flag; });
+        auto is_ready{[this]() {
+            return try_acquire();
+        }};
+
+        if (!WaitStrategy::spin_until(is_ready))
+            waiters.wait(is_ready);
     }
 
     template<class Rep, class Period>
     bool wait_for(const std::chrono::duration<Rep, Period>& duration)
     {
-        std::unique_lock lk{mux};
-        return cv.wait_for(lk, duration, [this]() { return flag; });
+        auto deadline{std::chrono::steady_clock::now() + duration};
+        auto is_ready{[this]() {
+            return try_acquire();
+        }};
+
+        if (WaitStrategy::spin_until(is_ready))
+            return true;
+        return waiters.wait_until(is_ready, deadline);
     }
 
-    bool is_set()
+    bool is_set() const
     {
-        std::lock_guard g{mux};
-        return flag;
+        return flag.load(std::memory_order_acquire);
     }
 
   private:
-    std::mutex mux;
-    std::condition_variable cv;
-    bool flag{false};
+    //! For the auto-reset flag only one of the competing waiters consumes the flag.
+    bool try_acquire()
+    {
+        if constexpr (AutoReset)
+        {
+            auto expected{true};
+            return flag.compare_exchange_strong(expected, false, std::memory_order_acquire, std::memory_order_relaxed);
+        } else
+        {
+            return is_set();
+        }
+    }
+
+    std::atomic<bool> flag{false};
+    native::eventcount waiters;
 };
 
+using flag = basic_flag<>;
+using auto_reset_flag = basic_flag<native::wait_strategy::park, true>;
+
+namespace native
+{
+using jungles::auto_reset_flag;
+using jungles::flag;
+} // namespace native
+
 } // namespace jungles
 
 #endif /* FLAG_HPP */
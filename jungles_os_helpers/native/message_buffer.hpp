@@ -0,0 +1,161 @@
+/**
+ * @file	message_buffer.hpp
+ * @brief	Message buffer for the native platform, with the same interface as the FreeRTOS one.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef NATIVE_MESSAGE_BUFFER_HPP
+#define NATIVE_MESSAGE_BUFFER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <span>
+
+#include "jungles_os_helpers/native/eventcount.hpp"
+#include "jungles_os_helpers/native/stream_buffer.hpp"
+
+namespace jungles::native
+{
+
+/**
+ * @brief Buffer of messages of variable length.
+ *
+ * Mirrors jungles::freertos::message_buffer, without the ISR variants: each receive gets exactly one message, and
+ * each message occupies its length plus sizeof(std::size_t) bytes of the capacity.
+ */
+template<std::size_t Capacity>
+class message_buffer
+{
+  public:
+    message_buffer() = default;
+    message_buffer(const message_buffer&) = delete;
+    message_buffer& operator=(const message_buffer&) = delete;
+    message_buffer(message_buffer&&) = delete;
+    message_buffer& operator=(message_buffer&&) = delete;
+
+    //! Blocks until there is space for the message. @return false when the message can never fit into the buffer.
+    bool send(std::span<const std::byte> message)
+    {
+        if (required_space(message) > Capacity)
+            return false;
+        space_freed.wait([&]() { return space_available() >= required_space(message); });
+        return write(message);
+    }
+
+    //! @return false when timeout occurred; nothing is written then.
+    bool send(std::span<const std::byte> message, unsigned timeout_ms)
+    {
+        if (required_space(message) > Capacity)
+            return false;
+        space_freed.wait_until([&]() { return space_available() >= required_space(message); },
+                               detail::deadline_after(timeout_ms));
+        return write(message);
+    }
+
+    /**
+     * @brief Blocks until a message is available.
+     * @return Length of the message; 0 when the buffer is too small for the message, which is then left in place.
+     */
+    std::size_t receive(std::span<std::byte> buffer)
+    {
+        not_empty.wait([this]() { return !is_empty(); });
+        return read(buffer);
+    }
+
+    //! @return Length of the message; 0 when timeout occurred or when the buffer is too small for the message.
+    std::size_t receive(std::span<std::byte> buffer, unsigned timeout_ms)
+    {
+        not_empty.wait_until([this]() { return !is_empty(); }, detail::deadline_after(timeout_ms));
+        return read(buffer);
+    }
+
+    //! @return Length of the next message, so that a buffer of the right size can be provided; 0 when empty.
+    std::size_t next_message_size()
+    {
+        std::lock_guard g{mux};
+        return ring.size() == 0 ? 0 : peek_length();
+    }
+
+    std::size_t space_available() const
+    {
+        return Capacity - num_bytes.load(std::memory_order_acquire);
+    }
+
+    //! Drops all the messages.
+    bool reset()
+    {
+        {
+            std::lock_guard g{mux};
+            ring.clear();
+            num_bytes.store(0, std::memory_order_release);
+        }
+        space_freed.notify_all();
+        return true;
+    }
+
+  private:
+    static std::size_t required_space(std::span<const std::byte> message)
+    {
+        return message.size() + sizeof(std::size_t);
+    }
+
+    bool is_empty() const
+    {
+        return num_bytes.load(std::memory_order_acquire) == 0;
+    }
+
+    //! Call only with the mux taken and when the ring is not empty.
+    std::size_t peek_length() const
+    {
+        std::size_t length;
+        ring.peek(std::as_writable_bytes(std::span{&length, 1}));
+        return length;
+    }
+
+    bool write(std::span<const std::byte> message)
+    {
+        {
+            std::lock_guard g{mux};
+            if (ring.space() < required_space(message))
+                return false;
+
+            auto length{message.size()};
+            ring.write(std::as_bytes(std::span{&length, 1}));
+            ring.write(message);
+            num_bytes.store(ring.size(), std::memory_order_release);
+        }
+        not_empty.notify_all();
+        return true;
+    }
+
+    std::size_t read(std::span<std::byte> buffer)
+    {
+        std::size_t length;
+        {
+            std::lock_guard g{mux};
+            if (ring.size() == 0)
+                return 0;
+
+            length = peek_length();
+            if (length > buffer.size())
+                return 0;
+
+            ring.drop(sizeof(length));
+            ring.read(buffer.first(length));
+            num_bytes.store(ring.size(), std::memory_order_release);
+        }
+        space_freed.notify_all();
+        return length;
+    }
+
+    std::mutex mux;
+    detail::byte_ring<Capacity> ring;
+    //! Mirrors ring.size(), so that the waiters can check it without taking the mux.
+    std::atomic<std::size_t> num_bytes{0};
+    eventcount not_empty;
+    eventcount space_freed;
+};
+
+} // namespace jungles::native
+
+#endif /* NATIVE_MESSAGE_BUFFER_HPP */
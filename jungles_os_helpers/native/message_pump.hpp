@@ -6,54 +6,373 @@
 #ifndef NATIVE_MESSAGE_PUMP_HPP
 #define NATIVE_MESSAGE_PUMP_HPP
 
-#include <condition_variable>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <deque>
+#include <iterator>
 #include <mutex>
 #include <optional>
-#include <queue>
+#include <ranges>
+#include <utility>
+
+#include "jungles_os_helpers/native/eventcount.hpp"
+#include "jungles_os_helpers/native/wait_strategy.hpp"
 
 namespace jungles::native
 {
 
-template<typename Message>
+/**
+ * The messages are published to the receivers in the order their slots were taken: a message filled in place, after
+ * reserve(), holds back the messages sent after its reservation until it is committed or dropped.
+ *
+ * \tparam Message Type of the message passed through the pump.
+ * \tparam WaitStrategy Policy from jungles::native::wait_strategy, applied by receive() before parking.
+ */
+template<typename Message, typename WaitStrategy = wait_strategy::park>
 class message_pump
 {
+    struct slot;
+
   public:
+    class reserved_slot;
+    class peeked_slot;
+
     void send(Message&& m)
     {
+        std::size_t count;
+        {
+            std::lock_guard g{mux};
+            slots.push_back(slot{std::move(m), slot_state::committed});
+            ++num_unpublished;
+            count = publish_lock_free();
+        }
+        notify_receivers(count);
+    }
+
+    //! Sends all the messages from the range under a single lock and with a single notification. The messages are
+    //! moved out of the range.
+    template<std::ranges::input_range Range>
+    void send_many(Range&& messages)
+    {
+        std::size_t count;
         {
             std::lock_guard g{mux};
-            queue.push(std::move(m));
+            for (auto&& m : messages)
+            {
+                slots.push_back(slot{std::move(m), slot_state::committed});
+                ++num_unpublished;
+            }
+            count = publish_lock_free();
         }
-        cv.notify_all();
+        notify_receivers(count);
     }
 
+    /**
+     * @brief Takes a slot at the back of the pump and constructs a message in it, to be filled in place.
+     *
+     * Lets large messages be filled where they are stored, instead of being moved into the pump. The pump is locked
+     * only while the slot is taken, so the other threads aren't blocked while the message is being filled. The message
+     * is published with reserved_slot::commit(); a slot destroyed without commit() is dropped.
+     */
+    template<typename... Args>
+    reserved_slot reserve(Args&&... args)
+    {
+        slot* s;
+        {
+            std::lock_guard g{mux};
+            // The references to the elements of a deque stay valid when elements are added or removed at its ends.
+            s = &slots.emplace_back();
+            ++num_unpublished;
+        }
+
+        try
+        {
+            s->message.emplace(std::forward<Args>(args)...);
+        } catch (...)
+        {
+            publish(*s, slot_state::dropped);
+            throw;
+        }
+        return reserved_slot{*this, *s};
+    }
+
+    //! Message constructed in place with reserve(), owned by the producer until it is published.
+    class reserved_slot
+    {
+      public:
+        reserved_slot(reserved_slot&& other) noexcept : pump{std::exchange(other.pump, nullptr)}, s{other.s}
+        {
+        }
+
+        reserved_slot& operator=(reserved_slot&&) = delete;
+
+        ~reserved_slot()
+        {
+            if (pump != nullptr)
+            {
+                s->message.reset();
+                pump->publish(*s, slot_state::dropped);
+            }
+        }
+
+        Message& operator*() const
+        {
+            return *s->message;
+        }
+
+        Message* operator->() const
+        {
+            return &*s->message;
+        }
+
+        void commit()
+        {
+            std::exchange(pump, nullptr)->publish(*s, slot_state::committed);
+        }
+
+      private:
+        friend class message_pump;
+
+        reserved_slot(message_pump& pump, slot& s) : pump{&pump}, s{&s}
+        {
+        }
+
+        message_pump* pump;
+        slot* s;
+    };
+
     Message receive()
     {
-        std::unique_lock ul{mux};
-        cv.wait(ul, [this]() { return !queue.empty(); });
-        return pop();
+        while (true)
+        {
+            wait_for_messages();
+
+            // Another receiver might have been faster.
+            if (auto m{receive_immediate()})
+                return std::move(*m);
+        }
+    }
+
+    /**
+     * @brief Blocks until at least one message is available and then receives up to max messages under a single lock.
+     * @return Number of messages written to the output iterator.
+     */
+    template<std::output_iterator<Message> OutputIt>
+    std::size_t receive_many(OutputIt out, std::size_t max)
+    {
+        if (max == 0)
+            return 0;
+
+        while (true)
+        {
+            wait_for_messages();
+
+            std::lock_guard g{mux};
+            std::size_t count{0};
+            for (; count < max and num_messages.load(std::memory_order_relaxed) != 0; ++count)
+                *out++ = pop();
+            if (count != 0)
+                return count;
+        }
     }
 
     std::optional<Message> receive_immediate()
     {
         std::lock_guard g{mux};
-        if (queue.empty())
+        if (num_messages.load(std::memory_order_relaxed) == 0)
             return std::nullopt;
         return pop();
     }
 
+    /**
+     * @brief Blocks until a message is available and gives access to it in place.
+     *
+     * The message stays at the front of the pump until peeked_slot::release() or the destruction of the returned
+     * object. The pump isn't locked meanwhile, so the producers aren't blocked. Only a pump with a single receiver may
+     * be peeked, because the other receivers would take the peeked message away.
+     */
+    peeked_slot peek()
+    {
+        while (true)
+        {
+            wait_for_messages();
+
+            std::lock_guard g{mux};
+            if (num_messages.load(std::memory_order_relaxed) != 0)
+                return peeked_slot{*this, *slots.front().message};
+        }
+    }
+
+    //! Message received in place with peek().
+    class peeked_slot
+    {
+      public:
+        peeked_slot(peeked_slot&& other) noexcept : pump{std::exchange(other.pump, nullptr)}, m{other.m}
+        {
+        }
+
+        peeked_slot& operator=(peeked_slot&&) = delete;
+
+        ~peeked_slot()
+        {
+            if (pump != nullptr)
+                pump->release();
+        }
+
+        Message& operator*() const
+        {
+            return *m;
+        }
+
+        Message* operator->() const
+        {
+            return m;
+        }
+
+        //! Removes the message from the pump.
+        void release()
+        {
+            std::exchange(pump, nullptr)->release();
+        }
+
+      private:
+        friend class message_pump;
+
+        peeked_slot(message_pump& pump, Message& m) : pump{&pump}, m{&m}
+        {
+        }
+
+        message_pump* pump;
+        Message* m;
+    };
+
+    bool is_empty() const
+    {
+        return num_messages.load(std::memory_order_acquire) == 0;
+    }
+
+    //! Used by jungles::native::pump_selector, which waits on multiple pumps. Pass nullptr to stop observing; the
+    //! senders which are notifying the previous observer at that moment are waited for, so it can be destroyed then.
+    void set_observer(eventcount* observer_)
+    {
+        std::lock_guard g{observer_mux};
+        observer.store(observer_, std::memory_order_release);
+    }
+
   private:
-    //! Call only if it is certain that the queue is not empty, and the mux must be taken while calling this function.
+    enum class slot_state
+    {
+        reserved,
+        committed,
+        dropped
+    };
+
+    struct slot
+    {
+        std::optional<Message> message;
+        slot_state state{slot_state::reserved};
+    };
+
+    /**
+     * @brief Publishes the unpublished slots in order, up to the first one which is still reserved.
+     * @return Number of the messages which have become available to the receivers.
+     */
+    std::size_t publish_lock_free()
+    {
+        auto first_unpublished{slots.size() - num_unpublished};
+        std::size_t count{0};
+        for (; num_unpublished != 0 and slots[first_unpublished].state != slot_state::reserved; --num_unpublished)
+            if (slots[first_unpublished++].state == slot_state::committed)
+                ++count;
+
+        drop_front_slots_lock_free();
+        num_messages.store(num_messages.load(std::memory_order_relaxed) + count, std::memory_order_release);
+        return count;
+    }
+
+    //! Finishes a reservation.
+    void publish(slot& s, slot_state state)
+    {
+        std::size_t count;
+        {
+            std::lock_guard g{mux};
+            s.state = state;
+            count = publish_lock_free();
+        }
+        notify_receivers(count);
+    }
+
+    //! Keeps the front slot committed whenever there are messages, so the receivers needn't skip the dropped slots.
+    void drop_front_slots_lock_free()
+    {
+        while (slots.size() != num_unpublished and slots.front().state == slot_state::dropped)
+            slots.pop_front();
+    }
+
+    void release()
+    {
+        std::lock_guard g{mux};
+        slots.pop_front();
+        num_messages.store(num_messages.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+        drop_front_slots_lock_free();
+    }
+
+    void notify_receivers(std::size_t count)
+    {
+        if (count == 0)
+            return;
+
+        // A single message can be consumed by a single receiver only, so there is no point in waking up the others.
+        if (count == 1)
+            not_empty.notify_one();
+        else
+            not_empty.notify(static_cast<int>(std::min<std::size_t>(count, INT_MAX)));
+        notify_observer();
+    }
+
+    void notify_observer()
+    {
+        // The lock is taken only when the pump is observed; it keeps the observer alive until it is notified.
+        if (observer.load(std::memory_order_acquire) == nullptr)
+            return;
+
+        std::lock_guard g{observer_mux};
+        if (auto o{observer.load(std::memory_order_relaxed)}; o != nullptr)
+            o->notify_one();
+    }
+
+    void wait_for_messages()
+    {
+        auto has_messages{[this]() {
+            return !is_empty();
+        }};
+
+        if (!WaitStrategy::spin_until(has_messages))
+            not_empty.wait(has_messages);
+    }
+
+    //! Call only if it is certain that there are messages, and the mux must be taken while calling this function.
     Message pop()
     {
-        auto r{std::move(queue.front())};
-        queue.pop();
+        auto r{std::move(*slots.front().message)};
+        slots.pop_front();
+        num_messages.store(num_messages.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+        drop_front_slots_lock_free();
         return r;
     }
 
-    std::condition_variable cv;
     std::mutex mux;
-    std::queue<Message> queue;
+    //! The published slots at the front, followed by num_unpublished slots at the back.
+    std::deque<slot> slots;
+    std::size_t num_unpublished{0};
+    //! Number of the committed messages in the published slots, so that the receivers can wait on it without taking
+    //! the mux.
+    std::atomic<std::size_t> num_messages{0};
+    eventcount not_empty;
+    std::mutex observer_mux;
+    std::atomic<eventcount*> observer{nullptr};
 };
 
 } // namespace jungles::native
@@ -0,0 +1,96 @@
+/**
+ * @file	pump_selector.hpp
+ * @brief	Waits on multiple native message pumps at once.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef JUNGLES_NATIVE_PUMP_SELECTOR_HPP
+#define JUNGLES_NATIVE_PUMP_SELECTOR_HPP
+
+#include <array>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <tuple>
+
+#include "jungles_os_helpers/generic/select_order.hpp"
+#include "jungles_os_helpers/native/eventcount.hpp"
+
+namespace jungles::native
+{
+
+template<typename T>
+concept SelectablePump = requires(T p, eventcount* observer)
+{
+    {
+        p.is_empty()
+        } -> std::same_as<bool>;
+    p.set_observer(observer);
+};
+
+/**
+ * @brief Blocks on a set of message pumps and tells which one is ready to be received from.
+ *
+ * The selector observes the pumps for its whole lifetime, and a pump can be observed by a single selector at a time.
+ * The selector only tells which pump has messages; the caller receives from it on its own, preferably with
+ * receive_immediate(), because another receiver of the same pump might have been faster.
+ */
+template<SelectablePump... Pumps>
+class pump_selector
+{
+  public:
+    static constexpr std::size_t num_pumps{sizeof...(Pumps)};
+
+    static_assert(num_pumps > 0, "Select from at least one pump");
+
+    explicit pump_selector(Pumps&... pumps) : pump_selector(generic::select_order::priority, pumps...)
+    {
+    }
+
+    pump_selector(generic::select_order order, Pumps&... pumps) : pumps{pumps...}, picker{order}
+    {
+        (pumps.set_observer(&ready), ...);
+    }
+
+    pump_selector(const pump_selector&) = delete;
+    pump_selector& operator=(const pump_selector&) = delete;
+    pump_selector(pump_selector&&) = delete;
+    pump_selector& operator=(pump_selector&&) = delete;
+
+    ~pump_selector()
+    {
+        std::apply([](auto&... pumps) { (pumps.set_observer(nullptr), ...); }, pumps);
+    }
+
+    //! @return Index of the ready pump, in the order the pumps were passed to the constructor.
+    std::size_t wait()
+    {
+        std::optional<std::size_t> idx;
+        ready.wait([&]() { return (idx = picker.pick(get_ready_pumps())).has_value(); });
+        return *idx;
+    }
+
+    //! @return Index of the ready pump, or std::nullopt on timeout.
+    template<class Rep, class Period>
+    std::optional<std::size_t> wait_for(const std::chrono::duration<Rep, Period>& duration)
+    {
+        std::optional<std::size_t> idx;
+        ready.wait_until([&]() { return (idx = picker.pick(get_ready_pumps())).has_value(); },
+                         std::chrono::steady_clock::now() + duration);
+        return idx;
+    }
+
+  private:
+    std::array<bool, num_pumps> get_ready_pumps() const
+    {
+        return std::apply([](auto&... pumps) { return std::array<bool, num_pumps>{!pumps.is_empty()...}; }, pumps);
+    }
+
+    std::tuple<Pumps&...> pumps;
+    generic::ready_picker<num_pumps> picker;
+    eventcount ready;
+};
+
+} // namespace jungles::native
+
+#endif /* JUNGLES_NATIVE_PUMP_SELECTOR_HPP */
@@ -0,0 +1,484 @@
+/**
+ * @file	shm_message_pump.hpp
+ * @brief	Message pump living in memory shared between processes (Linux only).
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef NATIVE_SHM_MESSAGE_PUMP_HPP
+#define NATIVE_SHM_MESSAGE_PUMP_HPP
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "jungles_os_helpers/native/eventcount.hpp"
+
+namespace jungles::native
+{
+
+/**
+ * @brief Bounded, lock-free, multi-producer multi-consumer message pump which can be used by multiple processes.
+ *
+ * The ring of fixed-size slots and the futex words used for blocking live in a shared memory segment, so the messages
+ * are exchanged between processes without any kernel socket path. Each process which uses the pump constructs its
+ * own shm_message_pump object bound to the same segment:
+ *  - by name, through shm_open(); the first process creates and initializes the segment, the others attach to it,
+ *  - by file descriptor, e.g. one inherited from or passed by the process which created an anonymous segment.
+ *
+ * Since the messages are shared byte-wise between address spaces, the Message type must be trivially copyable.
+ * When the ring is full, send() blocks until a receiver frees a slot. Attaching waits for the creator to initialize
+ * the segment up to the attach timeout, so that a creator which died in the meantime doesn't hang the other processes.
+ *
+ * send() and receive() copy the message into and out of the ring. To avoid the copies, construct the message in its
+ * slot with reserve() and read it there with peek().
+ *
+ * \tparam Message Type of the message passed through the pump.
+ * \tparam Capacity Number of slots in the ring; must be a power of two.
+ */
+template<typename Message, std::size_t Capacity = 64>
+class shm_message_pump
+{
+  public:
+    static_assert(std::is_trivially_copyable_v<Message>, "Messages are copied between processes byte-wise");
+    static_assert(Capacity > 1 and (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    //! Creates a new anonymous segment. Use native_handle() to share it with other processes.
+    shm_message_pump() : fd{memfd_create("jungles_shm_message_pump", MFD_CLOEXEC)}
+    {
+        throw_on_error(fd);
+        create_segment();
+    }
+
+    static constexpr std::chrono::milliseconds default_attach_timeout{std::chrono::seconds{1}};
+
+    //! Creates the named segment, or attaches to it if it already exists. Throws std::system_error with ETIMEDOUT,
+    //! when the existing segment is not initialized within the attach timeout.
+    explicit shm_message_pump(const char* name, std::chrono::milliseconds attach_timeout = default_attach_timeout)
+    {
+        fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+        if (fd != -1)
+        {
+            try
+            {
+                create_segment();
+            } catch (...)
+            {
+                // Otherwise the other processes would attach to a segment which is never initialized.
+                shm_unlink(name);
+                throw;
+            }
+            return;
+        }
+
+        if (errno != EEXIST)
+            throw_on_error(-1);
+
+        fd = shm_open(name, O_RDWR, 0);
+        throw_on_error(fd);
+        attach_segment(attach_timeout);
+    }
+
+    //! Attaches to the segment referred to by the file descriptor. The descriptor is duplicated. Throws
+    //! std::system_error with ETIMEDOUT, when the segment is not initialized within the attach timeout.
+    explicit shm_message_pump(int segment_fd, std::chrono::milliseconds attach_timeout = default_attach_timeout) :
+        fd{dup(segment_fd)}
+    {
+        throw_on_error(fd);
+        attach_segment(attach_timeout);
+    }
+
+    shm_message_pump(const shm_message_pump&) = delete;
+    shm_message_pump& operator=(const shm_message_pump&) = delete;
+    shm_message_pump(shm_message_pump&&) = delete;
+    shm_message_pump& operator=(shm_message_pump&&) = delete;
+
+    ~shm_message_pump()
+    {
+        if (seg != nullptr)
+            munmap(seg, sizeof(segment));
+        if (fd != -1)
+            close(fd);
+    }
+
+    //! Removes the name of a segment. The processes which have it mapped can still use it.
+    static void remove(const char* name)
+    {
+        shm_unlink(name);
+    }
+
+    int native_handle() const
+    {
+        return fd;
+    }
+
+    class reserved_slot;
+    class peeked_slot;
+
+    void send(Message&& m)
+    {
+        while (!try_send(m))
+            wait_not_full();
+    }
+
+    //! @return false when the ring is full.
+    bool try_send(const Message& m)
+    {
+        auto pos{claim_for_write()};
+        if (!pos)
+            return false;
+
+        new (slot_at(*pos).storage) Message(m);
+        publish(*pos, true);
+        return true;
+    }
+
+    //! Blocks until a slot is free and constructs the message in it. The message is published by
+    //! reserved_slot::commit().
+    template<typename... Args>
+    reserved_slot reserve(Args&&... args)
+    {
+        std::optional<std::uint64_t> pos;
+        while (!(pos = claim_for_write()))
+            wait_not_full();
+
+        try
+        {
+            new (slot_at(*pos).storage) Message(std::forward<Args>(args)...);
+        } catch (...)
+        {
+            publish(*pos, false);
+            throw;
+        }
+        return reserved_slot{*this, *pos};
+    }
+
+    Message receive()
+    {
+        while (true)
+        {
+            if (auto m{receive_immediate()})
+                return *m;
+            wait_not_empty();
+        }
+    }
+
+    std::optional<Message> receive_immediate()
+    {
+        auto pos{claim_for_read()};
+        if (!pos)
+            return std::nullopt;
+
+        std::optional<Message> r{*message_at(*pos)};
+        free_slot(*pos);
+        return r;
+    }
+
+    //! Blocks until a message is available and gives access to it in its slot. The slot is freed when the returned
+    //! object is destroyed or released.
+    peeked_slot peek()
+    {
+        while (true)
+        {
+            if (auto p{try_peek()})
+                return std::move(*p);
+            wait_not_empty();
+        }
+    }
+
+    //! @return std::nullopt when the ring is empty.
+    std::optional<peeked_slot> try_peek()
+    {
+        auto pos{claim_for_read()};
+        if (!pos)
+            return std::nullopt;
+        return peeked_slot{*this, *pos};
+    }
+
+    /**
+     * @brief Slot claimed with reserve(), holding the message constructed in the shared memory.
+     *
+     * The receivers stop at the slot until it is published, even if the slots reserved after it are committed
+     * earlier. A slot destroyed without commit() is published as empty and skipped by the receivers.
+     */
+    class reserved_slot
+    {
+      public:
+        reserved_slot(reserved_slot&& other) noexcept :
+            pump{std::exchange(other.pump, nullptr)}, pos{other.pos}
+        {
+        }
+
+        reserved_slot& operator=(reserved_slot&&) = delete;
+
+        ~reserved_slot()
+        {
+            if (pump != nullptr)
+                pump->publish(pos, false);
+        }
+
+        Message& operator*() const
+        {
+            return *pump->message_at(pos);
+        }
+
+        Message* operator->() const
+        {
+            return pump->message_at(pos);
+        }
+
+        void commit()
+        {
+            std::exchange(pump, nullptr)->publish(pos, true);
+        }
+
+      private:
+        friend class shm_message_pump;
+
+        reserved_slot(shm_message_pump& pump, std::uint64_t pos) : pump{&pump}, pos{pos}
+        {
+        }
+
+        shm_message_pump* pump;
+        std::uint64_t pos;
+    };
+
+    //! Message received in place with peek(). The slot stays taken until release() or the destruction.
+    class peeked_slot
+    {
+      public:
+        peeked_slot(peeked_slot&& other) noexcept : pump{std::exchange(other.pump, nullptr)}, pos{other.pos}
+        {
+        }
+
+        peeked_slot& operator=(peeked_slot&&) = delete;
+
+        ~peeked_slot()
+        {
+            if (pump != nullptr)
+                pump->free_slot(pos);
+        }
+
+        Message& operator*() const
+        {
+            return *pump->message_at(pos);
+        }
+
+        Message* operator->() const
+        {
+            return pump->message_at(pos);
+        }
+
+        void release()
+        {
+            std::exchange(pump, nullptr)->free_slot(pos);
+        }
+
+      private:
+        friend class shm_message_pump;
+
+        peeked_slot(shm_message_pump& pump, std::uint64_t pos) : pump{&pump}, pos{pos}
+        {
+        }
+
+        shm_message_pump* pump;
+        std::uint64_t pos;
+    };
+
+    bool is_empty() const
+    {
+        auto pos{seg->dequeue_pos.load(std::memory_order_acquire)};
+        return seg->slots[pos % Capacity].sequence.load(std::memory_order_acquire) != pos + 1;
+    }
+
+  private:
+    struct slot
+    {
+        std::atomic<std::uint64_t> sequence;
+        //! False for a slot whose reservation was dropped; published together with the sequence.
+        bool has_message;
+        alignas(Message) unsigned char storage[sizeof(Message)];
+    };
+
+    struct segment
+    {
+        std::atomic<std::uint32_t> is_initialized{0};
+        alignas(64) std::atomic<std::uint64_t> enqueue_pos{0};
+        alignas(64) std::atomic<std::uint64_t> dequeue_pos{0};
+        alignas(64) basic_eventcount<true> not_empty;
+        basic_eventcount<true> not_full;
+        slot slots[Capacity];
+    };
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free and std::atomic<std::uint32_t>::is_always_lock_free,
+                  "Only lock-free atomics are address-free and can be shared between processes");
+
+    slot& slot_at(std::uint64_t pos)
+    {
+        return seg->slots[pos % Capacity];
+    }
+
+    Message* message_at(std::uint64_t pos)
+    {
+        return std::launder(reinterpret_cast<Message*>(slot_at(pos).storage));
+    }
+
+    std::optional<std::uint64_t> claim_for_write()
+    {
+        auto pos{seg->enqueue_pos.load(std::memory_order_relaxed)};
+        while (true)
+        {
+            auto seq{slot_at(pos).sequence.load(std::memory_order_acquire)};
+            auto diff{static_cast<std::int64_t>(seq - pos)};
+            if (diff == 0)
+            {
+                if (seg->enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    return pos;
+            } else if (diff < 0)
+            {
+                return std::nullopt;
+            } else
+            {
+                pos = seg->enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void publish(std::uint64_t pos, bool has_message)
+    {
+        auto& s{slot_at(pos)};
+        s.has_message = has_message;
+        s.sequence.store(pos + 1, std::memory_order_release);
+        seg->not_empty.notify_one();
+    }
+
+    //! Skips the slots of the dropped reservations.
+    std::optional<std::uint64_t> claim_for_read()
+    {
+        auto pos{seg->dequeue_pos.load(std::memory_order_relaxed)};
+        while (true)
+        {
+            auto& s{slot_at(pos)};
+            auto seq{s.sequence.load(std::memory_order_acquire)};
+            auto diff{static_cast<std::int64_t>(seq - (pos + 1))};
+            if (diff == 0)
+            {
+                if (seg->dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    if (s.has_message)
+                        return pos;
+                    free_slot(pos);
+                    pos = seg->dequeue_pos.load(std::memory_order_relaxed);
+                }
+            } else if (diff < 0)
+            {
+                return std::nullopt;
+            } else
+            {
+                pos = seg->dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void free_slot(std::uint64_t pos)
+    {
+        slot_at(pos).sequence.store(pos + Capacity, std::memory_order_release);
+        seg->not_full.notify_one();
+    }
+
+    void wait_not_full()
+    {
+        seg->not_full.wait([this]() { return !is_full(); });
+    }
+
+    void wait_not_empty()
+    {
+        seg->not_empty.wait([this]() { return !is_empty(); });
+    }
+
+    bool is_full() const
+    {
+        auto pos{seg->enqueue_pos.load(std::memory_order_acquire)};
+        return seg->slots[pos % Capacity].sequence.load(std::memory_order_acquire) != pos;
+    }
+
+    void create_segment()
+    {
+        throw_on_error(ftruncate(fd, sizeof(segment)));
+        map_segment();
+
+        seg = new (seg) segment;
+        for (std::size_t i{0}; i < Capacity; ++i)
+            seg->slots[i].sequence.store(i, std::memory_order_relaxed);
+        seg->is_initialized.store(1, std::memory_order_release);
+    }
+
+    void attach_segment(std::chrono::milliseconds timeout)
+    {
+        auto deadline{std::chrono::steady_clock::now() + timeout};
+        auto throw_on_timeout{[&]() {
+            if (std::chrono::steady_clock::now() < deadline)
+                return;
+            if (seg != nullptr)
+                munmap(std::exchange(seg, nullptr), sizeof(segment));
+            errno = ETIMEDOUT;
+            throw_on_error(-1);
+        }};
+
+        // The creator might not have resized the segment yet.
+        struct stat st;
+        while (true)
+        {
+            throw_on_error(fstat(fd, &st));
+            if (static_cast<std::size_t>(st.st_size) >= sizeof(segment))
+                break;
+            throw_on_timeout();
+            std::this_thread::yield();
+        }
+
+        map_segment();
+
+        while (seg->is_initialized.load(std::memory_order_acquire) == 0)
+        {
+            throw_on_timeout();
+            std::this_thread::yield();
+        }
+    }
+
+    void map_segment()
+    {
+        auto addr{mmap(nullptr, sizeof(segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)};
+        if (addr == MAP_FAILED)
+            throw_on_error(-1);
+        seg = static_cast<segment*>(addr);
+    }
+
+    void throw_on_error(int result)
+    {
+        if (result == -1)
+        {
+            auto error{errno};
+            if (fd != -1)
+                close(fd);
+            throw std::system_error{error, std::generic_category()};
+        }
+    }
+
+    int fd{-1};
+    segment* seg{nullptr};
+};
+
+} // namespace jungles::native
+
+#endif /* NATIVE_SHM_MESSAGE_PUMP_HPP */
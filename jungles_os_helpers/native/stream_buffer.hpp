@@ -0,0 +1,228 @@
+/**
+ * @file	stream_buffer.hpp
+ * @brief	Stream buffer for the native platform, with the same interface as the FreeRTOS one.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef NATIVE_STREAM_BUFFER_HPP
+#define NATIVE_STREAM_BUFFER_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <span>
+
+#include "jungles_os_helpers/native/eventcount.hpp"
+
+namespace jungles::native
+{
+
+namespace detail
+{
+
+//! Circular buffer of bytes. Not thread-safe.
+template<std::size_t Capacity>
+class byte_ring
+{
+  public:
+    std::size_t size() const
+    {
+        return count;
+    }
+
+    std::size_t space() const
+    {
+        return Capacity - count;
+    }
+
+    //! Call only when there is space for the data.
+    void write(std::span<const std::byte> data)
+    {
+        auto head{(tail + count) % Capacity};
+        auto first_chunk{std::min(data.size(), Capacity - head)};
+        std::copy_n(data.begin(), first_chunk, bytes.begin() + head);
+        std::copy(data.begin() + first_chunk, data.end(), bytes.begin());
+        count += data.size();
+    }
+
+    //! Call only when there are at least as many bytes as the buffer size.
+    void peek(std::span<std::byte> buffer) const
+    {
+        auto first_chunk{std::min(buffer.size(), Capacity - tail)};
+        std::copy_n(bytes.begin() + tail, first_chunk, buffer.begin());
+        std::copy_n(bytes.begin(), buffer.size() - first_chunk, buffer.begin() + first_chunk);
+    }
+
+    //! Call only when there are at least as many bytes as the buffer size.
+    void read(std::span<std::byte> buffer)
+    {
+        peek(buffer);
+        drop(buffer.size());
+    }
+
+    void drop(std::size_t num_bytes)
+    {
+        tail = (tail + num_bytes) % Capacity;
+        count -= num_bytes;
+    }
+
+    void clear()
+    {
+        drop(count);
+    }
+
+  private:
+    std::array<std::byte, Capacity> bytes;
+    std::size_t tail{0}, count{0};
+};
+
+inline auto deadline_after(unsigned timeout_ms)
+{
+    return std::chrono::steady_clock::now() + std::chrono::milliseconds{timeout_ms};
+}
+
+} // namespace detail
+
+/**
+ * @brief Byte stream of a fixed capacity.
+ *
+ * Mirrors jungles::freertos::stream_buffer, without the ISR variants: the bytes are copied straight from the writer's
+ * span to the buffer and from the buffer to the reader's span, and a reader which waits on an empty buffer is woken up
+ * when the trigger level is reached.
+ */
+template<std::size_t Capacity>
+class stream_buffer
+{
+  public:
+    //! @param trigger_level Number of bytes which must be in the buffer, before a blocked reader is woken up.
+    explicit stream_buffer(std::size_t trigger_level = 1)
+    {
+        set_trigger_level(trigger_level);
+    }
+
+    stream_buffer(const stream_buffer&) = delete;
+    stream_buffer& operator=(const stream_buffer&) = delete;
+    stream_buffer(stream_buffer&&) = delete;
+    stream_buffer& operator=(stream_buffer&&) = delete;
+
+    //! Blocks until there is space for all the data, or for Capacity bytes if there is more. @return Bytes written.
+    std::size_t send(std::span<const std::byte> data)
+    {
+        space_freed.wait([&]() { return has_space_for(data.size()); });
+        return write(data);
+    }
+
+    //! @return Number of bytes written; when timeout occurred, only as many bytes as fit are written.
+    std::size_t send(std::span<const std::byte> data, unsigned timeout_ms)
+    {
+        space_freed.wait_until([&]() { return has_space_for(data.size()); }, detail::deadline_after(timeout_ms));
+        return write(data);
+    }
+
+    //! Returns right away when the buffer is not empty, otherwise blocks until the trigger level is reached.
+    //! @return Number of bytes read.
+    std::size_t receive(std::span<std::byte> buffer)
+    {
+        if (is_empty())
+            data_available.wait([this]() { return is_trigger_level_reached(); });
+        return read(buffer);
+    }
+
+    //! @return Number of bytes read; when timeout occurred, the bytes available are read, even below the trigger level.
+    std::size_t receive(std::span<std::byte> buffer, unsigned timeout_ms)
+    {
+        if (is_empty())
+            data_available.wait_until([this]() { return is_trigger_level_reached(); },
+                                      detail::deadline_after(timeout_ms));
+        return read(buffer);
+    }
+
+    //! @return false when the trigger level is bigger than the capacity.
+    bool set_trigger_level(std::size_t level)
+    {
+        if (level > Capacity)
+            return false;
+        trigger_level.store(std::max<std::size_t>(level, 1), std::memory_order_relaxed);
+        return true;
+    }
+
+    std::size_t bytes_available() const
+    {
+        return num_bytes.load(std::memory_order_acquire);
+    }
+
+    std::size_t space_available() const
+    {
+        return Capacity - bytes_available();
+    }
+
+    //! Drops all the bytes.
+    bool reset()
+    {
+        {
+            std::lock_guard g{mux};
+            ring.clear();
+            num_bytes.store(0, std::memory_order_release);
+        }
+        space_freed.notify_all();
+        return true;
+    }
+
+  private:
+    bool is_empty() const
+    {
+        return bytes_available() == 0;
+    }
+
+    bool is_trigger_level_reached() const
+    {
+        return bytes_available() >= trigger_level.load(std::memory_order_relaxed);
+    }
+
+    bool has_space_for(std::size_t size) const
+    {
+        return space_available() >= std::min(size, Capacity);
+    }
+
+    std::size_t write(std::span<const std::byte> data)
+    {
+        std::size_t written;
+        {
+            std::lock_guard g{mux};
+            written = std::min(data.size(), ring.space());
+            ring.write(data.first(written));
+            num_bytes.store(ring.size(), std::memory_order_release);
+        }
+        if (written != 0)
+            data_available.notify_all();
+        return written;
+    }
+
+    std::size_t read(std::span<std::byte> buffer)
+    {
+        std::size_t read;
+        {
+            std::lock_guard g{mux};
+            read = std::min(buffer.size(), ring.size());
+            ring.read(buffer.first(read));
+            num_bytes.store(ring.size(), std::memory_order_release);
+        }
+        if (read != 0)
+            space_freed.notify_all();
+        return read;
+    }
+
+    std::mutex mux;
+    detail::byte_ring<Capacity> ring;
+    //! Mirrors ring.size(), so that the waiters can check it without taking the mux.
+    std::atomic<std::size_t> num_bytes{0};
+    std::atomic<std::size_t> trigger_level{1};
+    eventcount data_available;
+    eventcount space_freed;
+};
+
+} // namespace jungles::native
+
+#endif /* NATIVE_STREAM_BUFFER_HPP */
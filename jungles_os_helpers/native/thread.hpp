@@ -6,21 +6,41 @@
 #ifndef JUNGLES_NATIVE_THREAD_HPP
 #define JUNGLES_NATIVE_THREAD_HPP
 
+#include <atomic>
 #include <thread>
 #include <functional>
 
+#include <unistd.h>
+
+#include "jungles_os_helpers/native/thread_stats.hpp"
+
 namespace jungles
 {
 
 namespace native
 {
 
+/**
+ * @brief Wraps std::thread, adding the statistics of the thread.
+ *
+ * Unlike std::thread it is neither copyable nor movable: the started thread stores its id in the object.
+ */
 class thread 
 {
   public:
+    thread() = default;
+    thread(const thread&) = delete;
+    thread& operator=(const thread&) = delete;
+    thread(thread&&) = delete;
+    thread& operator=(thread&&) = delete;
+
     void start(std::function<void(void)> f)
     {
-        underlying_thread = std::thread{std::move(f)};
+        underlying_thread = std::thread{[this, f = std::move(f)]() {
+            tid.store(gettid());
+            tid.notify_all();
+            f();
+        }};
     }
 
     void join()
@@ -28,8 +48,20 @@ class thread
         underlying_thread.join();
     }
 
+    //! Samples the statistics of the thread; the CPU share is computed since the previous call.
+    thread_stats stats()
+    {
+        if (!underlying_thread.joinable())
+            return {};
+
+        tid.wait(0);
+        return sampler.sample(underlying_thread.native_handle(), tid.load());
+    }
+
   private:
     std::thread underlying_thread;
+    std::atomic<pid_t> tid{0};
+    detail::thread_stats_sampler sampler;
 };
 
 } // namespace native
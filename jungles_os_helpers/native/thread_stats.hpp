@@ -0,0 +1,103 @@
+/**
+ * @file	thread_stats.hpp
+ * @brief	Statistics of a native thread, the counterpart of jungles::freertos::thread_stats (Linux only).
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef NATIVE_THREAD_STATS_HPP
+#define NATIVE_THREAD_STATS_HPP
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <optional>
+#include <string>
+
+#include <pthread.h>
+#include <sys/types.h>
+#include <time.h>
+
+namespace jungles::native
+{
+
+/**
+ * @brief Statistics of a thread.
+ *
+ * Unlike on FreeRTOS, there is no stack high-water mark, because the stack of a native thread is committed lazily by
+ * the kernel and it is not tracked per thread.
+ */
+struct thread_stats
+{
+    //! CPU time consumed by the thread.
+    std::chrono::nanoseconds runtime{0};
+
+    //! CPU share since the previous sample, in permille of the wall-clock time.
+    unsigned cpu_share_permille{0};
+
+    //! The state from /proc/self/task/<tid>/stat, e.g. 'R' (running) or 'S' (sleeping). 'X' when the thread code has
+    //! finished, '\0' when the thread is not started or already joined.
+    char state{'\0'};
+};
+
+namespace detail
+{
+
+//! Remembers the previous sample, to compute the CPU share between two consecutive samples.
+class thread_stats_sampler
+{
+  public:
+    thread_stats sample(pthread_t thread, pid_t tid)
+    {
+        thread_stats s{.state = read_state(tid)};
+        auto now{std::chrono::steady_clock::now()};
+
+        clockid_t cid;
+        timespec ts;
+        if (s.state == 'X' or pthread_getcpuclockid(thread, &cid) != 0 or clock_gettime(cid, &ts) != 0)
+        {
+            s.state = 'X';
+            s.runtime = last_runtime;
+            return s;
+        }
+
+        s.runtime = std::chrono::seconds{ts.tv_sec} + std::chrono::nanoseconds{ts.tv_nsec};
+        if (last_sample_time)
+        {
+            auto wall_time_delta{now - *last_sample_time};
+            if (wall_time_delta.count() != 0)
+                s.cpu_share_permille = static_cast<unsigned>((s.runtime - last_runtime) * 1000 / wall_time_delta);
+        }
+
+        last_runtime = s.runtime;
+        last_sample_time = now;
+        return s;
+    }
+
+  private:
+    static char read_state(pid_t tid)
+    {
+        auto path{"/proc/self/task/" + std::to_string(tid) + "/stat"};
+        auto f{std::fopen(path.c_str(), "r")};
+        if (f == nullptr)
+            return 'X';
+
+        char buf[256];
+        auto n{std::fread(buf, 1, sizeof(buf) - 1, f)};
+        std::fclose(f);
+        buf[n] = '\0';
+
+        // The format is "tid (comm) state ...", where comm may contain spaces and parentheses.
+        auto comm_end{std::strrchr(buf, ')')};
+        if (comm_end == nullptr or comm_end[1] == '\0' or comm_end[2] == '\0')
+            return 'X';
+        return comm_end[2];
+    }
+
+    std::chrono::nanoseconds last_runtime{0};
+    std::optional<std::chrono::steady_clock::time_point> last_sample_time;
+};
+
+} // namespace detail
+
+} // namespace jungles::native
+
+#endif /* NATIVE_THREAD_STATS_HPP */
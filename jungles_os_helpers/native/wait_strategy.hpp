@@ -0,0 +1,86 @@
+/**
+ * @file	wait_strategy.hpp
+ * @brief	Waiting policies for the native primitives: spin, then yield, then park.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#ifndef JUNGLES_NATIVE_WAIT_STRATEGY_HPP
+#define JUNGLES_NATIVE_WAIT_STRATEGY_HPP
+
+#include <thread>
+
+namespace jungles::native
+{
+
+namespace detail
+{
+
+//! Hints the CPU that we are inside a spin-wait loop.
+static inline void cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+} // namespace detail
+
+/**
+ * @brief Waiting policies used by the native message pump and flag.
+ *
+ * A policy decides what happens before the waiter goes to sleep in the kernel. It implements
+ * `static bool spin_until(Predicate)`, which returns true when the predicate became true before the policy's budget was
+ * exhausted. The primitive parks the thread afterwards, if the predicate is still false. The predicate is called
+ * without any lock taken, so it must be cheap and thread-safe, e.g. a single atomic load.
+ */
+namespace wait_strategy
+{
+
+//! Goes straight to sleep. Preferred for power-sensitive actives which are mostly idle.
+struct park
+{
+    template<typename Predicate>
+    static bool spin_until(Predicate&&)
+    {
+        return false;
+    }
+};
+
+/**
+ * @brief Spins with a pause instruction, then yields the CPU, then parks.
+ * \tparam SpinIterations Number of busy-wait iterations with the pause instruction.
+ * \tparam YieldIterations Number of std::this_thread::yield() calls after spinning is done.
+ */
+template<unsigned SpinIterations, unsigned YieldIterations>
+struct spin_then_park
+{
+    template<typename Predicate>
+    static bool spin_until(Predicate&& is_ready)
+    {
+        for (unsigned i{0}; i < SpinIterations; ++i)
+        {
+            if (is_ready())
+                return true;
+            detail::cpu_relax();
+        }
+
+        for (unsigned i{0}; i < YieldIterations; ++i)
+        {
+            if (is_ready())
+                return true;
+            std::this_thread::yield();
+        }
+
+        return is_ready();
+    }
+};
+
+//! Burns a few microseconds of CPU before parking. For latency-critical actives.
+using low_latency = spin_then_park<4096, 64>;
+
+} // namespace wait_strategy
+
+} // namespace jungles::native
+
+#endif /* JUNGLES_NATIVE_WAIT_STRATEGY_HPP */
@@ -69,7 +69,7 @@ struct EnumToBits
     static_assert(detail::are_all_same<decltype(Events)...>::value, "The enumerations must have the same type");
     static_assert(detail::unique_values<Events...>::value <= sizeof(UnderlyingType) * 8,
                   "Maximum of sizeof(UnderlyingType) events are supported");
-    static_assert(MaxEnumValue <= sizeof(UnderlyingType) * 8, "The maximum enumeration value is too high");
+    static_assert(MaxEnumValue < sizeof(UnderlyingType) * 8, "The maximum enumeration value is too high");
     static_assert(MinEnumValue >= 0, "Only non-negative values are supported");
 
     using value_type = typename detail::first_type<decltype(Events)...>::value;
@@ -85,7 +85,7 @@ struct EnumToBits
         for (auto e : evts)
         {
             auto underlying_value{static_cast<unsigned>(e)};
-            bits |= 1 << underlying_value;
+            bits |= UnderlyingType{1} << underlying_value;
         }
 
         return bits;
@@ -103,7 +103,7 @@ struct EnumToBits
         for (auto e : evts)
         {
             auto underlying_value{static_cast<unsigned>(e)};
-            bits |= 1 << underlying_value;
+            bits |= UnderlyingType{1} << underlying_value;
         }
 
         return bits;
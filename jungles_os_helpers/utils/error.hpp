@@ -0,0 +1,37 @@
+/**
+ * @file        error.hpp
+ * @brief       Reports errors with exceptions or, in the exception-free mode, with return codes only.
+ */
+#ifndef JUNGLES_OS_HELPERS_ERROR_HPP
+#define JUNGLES_OS_HELPERS_ERROR_HPP
+
+// Exceptions are used when they are enabled in the compiler, unless JUNGLES_OS_HELPERS_NO_EXCEPTIONS is defined.
+#if defined(JUNGLES_OS_HELPERS_NO_EXCEPTIONS) or !defined(__cpp_exceptions)
+#define JUNGLES_OS_HELPERS_EXCEPTIONS_ENABLED 0
+#else
+#define JUNGLES_OS_HELPERS_EXCEPTIONS_ENABLED 1
+#endif
+
+namespace jungles::utils
+{
+
+/**
+ * @brief Throws the Error, or returns the error code in the exception-free mode.
+ *
+ * The functions which can fail return an error code in both modes, so that their signatures don't depend on the mode,
+ * e.g.: return report_error<queue_full_error>(false);
+ */
+template<typename Error, typename ErrorCode>
+inline ErrorCode report_error(ErrorCode error_code)
+{
+#if JUNGLES_OS_HELPERS_EXCEPTIONS_ENABLED
+    (void) error_code;
+    throw Error{};
+#else
+    return error_code;
+#endif
+}
+
+}; // namespace jungles::utils
+
+#endif /* JUNGLES_OS_HELPERS_ERROR_HPP */
@@ -0,0 +1,104 @@
+/**
+ * @file        event_set.hpp
+ * @brief       Set of events, backed by the bits of an event group, e.g. as returned by event_group::wait_any().
+ */
+#ifndef EVENT_SET_HPP
+#define EVENT_SET_HPP
+
+#include <bit>
+#include <cstddef>
+#include <iterator>
+
+namespace jungles::utils
+{
+
+//! The event with value N is represented by bit N.
+template<typename EnumType, typename Bits>
+class event_set
+{
+  public:
+    class iterator
+    {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = EnumType;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = EnumType;
+
+        constexpr iterator() = default;
+
+        constexpr explicit iterator(Bits remaining) : remaining{remaining}
+        {
+        }
+
+        constexpr EnumType operator*() const
+        {
+            return static_cast<EnumType>(std::countr_zero(remaining));
+        }
+
+        constexpr iterator& operator++()
+        {
+            remaining &= remaining - 1;
+            return *this;
+        }
+
+        constexpr iterator operator++(int)
+        {
+            auto r{*this};
+            ++*this;
+            return r;
+        }
+
+        constexpr bool operator==(const iterator&) const = default;
+
+      private:
+        Bits remaining{0};
+    };
+
+    constexpr event_set() = default;
+
+    constexpr explicit event_set(Bits bits) : bits{bits}
+    {
+    }
+
+    constexpr bool contains(EnumType e) const
+    {
+        return (bits & (Bits{1} << static_cast<unsigned>(e))) != 0;
+    }
+
+    constexpr bool empty() const
+    {
+        return bits == 0;
+    }
+
+    constexpr std::size_t size() const
+    {
+        return std::popcount(bits);
+    }
+
+    constexpr Bits to_bits() const
+    {
+        return bits;
+    }
+
+    //! Iterates over the events in the order of their values.
+    constexpr iterator begin() const
+    {
+        return iterator{bits};
+    }
+
+    constexpr iterator end() const
+    {
+        return iterator{};
+    }
+
+    constexpr bool operator==(const event_set&) const = default;
+
+  private:
+    Bits bits{0};
+};
+
+} // namespace jungles::utils
+
+#endif /* EVENT_SET_HPP */
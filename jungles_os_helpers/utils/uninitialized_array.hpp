@@ -0,0 +1,62 @@
+/**
+ * @file        uninitialized_array.hpp
+ * @brief       Fixed-size storage for objects which are constructed and destroyed on demand.
+ */
+#ifndef UNINITIALIZED_ARRAY_HPP
+#define UNINITIALIZED_ARRAY_HPP
+
+#include <array>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace jungles::utils
+{
+
+/**
+ * @brief Storage for up to Size objects, none of which is constructed up front.
+ *
+ * Doesn't track which slots hold live objects: the owner shall construct each slot before accessing it, and destroy
+ * all the live objects before the storage goes away.
+ */
+template<typename T, std::size_t Size>
+class uninitialized_array
+{
+  public:
+    template<typename... Args>
+    void construct(std::size_t index, Args&&... args)
+    {
+        new (slots[index].storage) T(std::forward<Args>(args)...);
+    }
+
+    T& operator[](std::size_t index)
+    {
+        return *std::launder(reinterpret_cast<T*>(slots[index].storage));
+    }
+
+    void destroy(std::size_t index)
+    {
+        (*this)[index].~T();
+    }
+
+    //! Moves the object out of the slot and destroys what is left in the slot.
+    T take(std::size_t index)
+    {
+        auto& object{(*this)[index]};
+        T r{std::move(object)};
+        object.~T();
+        return r;
+    }
+
+  private:
+    struct slot
+    {
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    std::array<slot, Size> slots;
+};
+
+}; // namespace jungles::utils
+
+#endif /* UNINITIALIZED_ARRAY_HPP */
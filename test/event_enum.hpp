@@ -49,7 +49,31 @@ enum class Event
     e37,
     e38,
     e39,
-    e40
+    e40,
+    e41,
+    e42,
+    e43,
+    e44,
+    e45,
+    e46,
+    e47,
+    e48,
+    e49,
+    e50,
+    e51,
+    e52,
+    e53,
+    e54,
+    e55,
+    e56,
+    e57,
+    e58,
+    e59,
+    e60,
+    e61,
+    e62,
+    e63,
+    e64
 };
 
 }
@@ -47,7 +47,7 @@
 #define configMINIMAL_STACK_SIZE                   ( ( unsigned short ) 60 )
 #define configTOTAL_HEAP_SIZE                      ( ( size_t ) ( 2048U * 1024U ) )
 #define configMAX_TASK_NAME_LEN                    ( 15 )
-#define configUSE_TRACE_FACILITY                   0
+#define configUSE_TRACE_FACILITY                   1
 #define configUSE_16_BIT_TICKS                     0
 #define configIDLE_SHOULD_YIELD                    1
 #define configUSE_CO_ROUTINES                      0
@@ -56,6 +56,7 @@
 #define configQUEUE_REGISTRY_SIZE                  0
 #define configUSE_APPLICATION_TASK_TAG             1
 #define configUSE_COUNTING_SEMAPHORES              1
+#define configUSE_QUEUE_SETS                       1
 #define configUSE_ALTERNATIVE_API                  0
 #define configNUM_THREAD_LOCAL_STORAGE_POINTERS    3      /* FreeRTOS+FAT requires 2 pointers if a CWD is supported. */
 #define configRECORD_STACK_HIGH_ADDRESS            0
@@ -75,8 +76,17 @@
 /* Event group related definitions. */
 #define configUSE_EVENT_GROUPS                     1
 
-/* Run time stats gathering definitions. */
-#define configGENERATE_RUN_TIME_STATS    0
+/* Run time stats gathering definitions. The counter, in microseconds, is defined in main.cpp. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+unsigned long ulGetRunTimeCounterValue( void );
+#ifdef __cplusplus
+}
+#endif
+#define configGENERATE_RUN_TIME_STATS              1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()           ulGetRunTimeCounterValue()
 
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES                   0
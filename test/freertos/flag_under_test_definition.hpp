@@ -10,3 +10,8 @@ inline jungles::freertos::flag get_flag_implementation_under_test()
 {
     return jungles::freertos::flag{};
 }
+
+inline jungles::freertos::auto_reset_flag get_auto_reset_flag_implementation_under_test()
+{
+    return jungles::freertos::auto_reset_flag{};
+}
@@ -6,6 +6,7 @@
 #include "catch2/catch_session.hpp"
 
 #include <algorithm>
+#include <ctime>
 #include <iostream>
 #include <thread>
 
@@ -73,6 +74,14 @@ extern "C" void vApplicationGetTimerTaskMemory(StaticTask_t** ppxTimerTaskTCBBuf
 // --------------------------------------------------------------------------------------------------------------------
 // --------------------------------------------------------------------------------------------------------------------
 
+//! The run time stats counter, in microseconds.
+extern "C" unsigned long ulGetRunTimeCounterValue(void)
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<unsigned long>(now.tv_sec) * 1000000ul + static_cast<unsigned long>(now.tv_nsec) / 1000ul;
+}
+
 int main(int argc, char* argv[])
 {
     static int result{1};
@@ -0,0 +1,136 @@
+/**
+ * @file        no_exceptions_build_test.cpp
+ * @brief       Instantiates the FreeRTOS wrappers to check that they compile with -fno-exceptions -fno-rtti.
+ */
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+
+#include "jungles_os_helpers/freertos/active.hpp"
+#include "jungles_os_helpers/freertos/barrier.hpp"
+#include "jungles_os_helpers/freertos/event_group.hpp"
+#include "jungles_os_helpers/freertos/flag.hpp"
+#include "jungles_os_helpers/freertos/isr_to_task_queue.hpp"
+#include "jungles_os_helpers/freertos/message_buffer.hpp"
+#include "jungles_os_helpers/freertos/queue.hpp"
+#include "jungles_os_helpers/freertos/queue_selector.hpp"
+#include "jungles_os_helpers/freertos/queue_sending_from_isr.hpp"
+#include "jungles_os_helpers/freertos/single_consumer_queue.hpp"
+#include "jungles_os_helpers/freertos/single_waiter_event_group.hpp"
+#include "jungles_os_helpers/freertos/static_thread.hpp"
+#include "jungles_os_helpers/freertos/stream_buffer.hpp"
+#include "jungles_os_helpers/freertos/thread.hpp"
+#include "jungles_os_helpers/freertos/thread_pool.hpp"
+
+static_assert(JUNGLES_OS_HELPERS_EXCEPTIONS_ENABLED == 0);
+
+using namespace jungles::freertos;
+
+bool use_queue(queue<int, 4>& q)
+{
+    std::array<int, 2> batch{1, 2};
+    std::array<int, 4> received;
+
+    auto r{q.send(1)};
+    r = r and q.try_send(2);
+    r = r and q.send(3, 10);
+    r = r and q.send_many(batch);
+    if (auto elem{q.try_reserve()})
+    {
+        **elem = 4;
+        elem->commit();
+    }
+    r = r and q.receive_many(std::begin(received), received.size(), 0) != 0;
+    return r and q.receive(0).has_value();
+}
+
+bool use_single_consumer_queue(single_consumer_queue<int, 4>& q)
+{
+    std::array<int, 4> received;
+
+    auto r{q.send(1)};
+    r = r and q.try_send(2);
+    r = r and q.send(3, 10);
+    r = r and q.receive_many(std::begin(received), received.size(), 0) != 0;
+    return r and !q.receive(0).has_value();
+}
+
+bool use_isr_to_task_queue(isr_to_task_queue<int, 4>& q)
+{
+    std::array<int, 4> received;
+
+    auto r{q.send_from_isr(1)};
+    r = r and q.receive_many(std::begin(received), received.size(), 0) != 0;
+    return r and !q.receive(0).has_value();
+}
+
+bool use_queue_selector(queue<int, 4>& q1, queue<int, 4>& q2)
+{
+    queue_selector selector{q1, q2};
+    if (auto idx{selector.wait(0)}; idx)
+        return (*idx == 0 ? q1 : q2).receive(0).has_value();
+    return false;
+}
+
+bool use_byte_buffers(stream_buffer<64>& stream, message_buffer<64>& messages)
+{
+    std::array<std::byte, 8> data{};
+
+    auto r{stream.send(data, 0) == data.size()};
+    r = r and stream.receive(data, 0) == data.size();
+    r = r and messages.send(data, 0);
+    return r and messages.receive(data, 0) == data.size();
+}
+
+enum class event
+{
+    e1,
+    e2
+};
+
+bool use_event_groups(event_group<event::e1, event::e2>& group,
+                      single_waiter_event_group<event::e1, event::e2>& single_waiter_group,
+                      barrier<event::e1, event::e2>& b)
+{
+    group.set<event::e1>();
+    auto r{group.wait_one<event::e1, event::e2>(std::chrono::milliseconds{0}).has_value()};
+    r = r and group.set_from_isr<event::e2>();
+    r = r and !group.wait_any<event::e1, event::e2>(std::chrono::milliseconds{0}).empty();
+
+    single_waiter_group.set<event::e1, event::e2>();
+    r = r and single_waiter_group.wait_all<event::e1, event::e2>(std::chrono::milliseconds{0});
+
+    return r and b.arrive_and_wait<event::e1>(std::chrono::milliseconds{0});
+}
+
+bool use_thread(thread& t)
+{
+    t.start([]() {});
+    return t.join() == thread::status::ok and t.detach() == thread::status::already_joined;
+}
+
+bool use_static_thread(static_thread<512>& t)
+{
+    t.start([]() {});
+    return t.join() == thread::status::ok;
+}
+
+bool use_active()
+{
+    active<int, 4> a{[](int&&) {}, "no_exceptions", 512, 1};
+    return a.send(1);
+}
+
+bool use_thread_pool()
+{
+    ::freertos::thread_pool<2, 4, ::freertos::ThreadPoolConfig{512, 1}> pool;
+    return pool.execute([]() {});
+}
+
+void use_flag(flag& f)
+{
+    f.set();
+    f.wait();
+}
@@ -0,0 +1,56 @@
+/**
+ * @file        test_barrier.cpp
+ * @brief       Barrier tests.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+
+#include "../event_enum.hpp"
+#include "jungles_os_helpers/freertos/barrier.hpp"
+
+#include "thread_under_test_definition.hpp"
+
+using namespace jungles::freertos;
+using namespace test_helpers;
+
+TEST_CASE("Barrier synchronizes the participants", "[Barrier]")
+{
+    barrier<Event::e1, Event::e2, Event::e3> b;
+
+    SECTION("Times out when not all the participants arrive")
+    {
+        REQUIRE_FALSE(b.arrive_and_wait<Event::e1>(std::chrono::milliseconds{10}));
+    }
+
+    SECTION("No participant passes before all of them arrive, in each cycle")
+    {
+        constexpr unsigned cycles{100};
+        std::atomic<unsigned> arrivals{0};
+        std::atomic<bool> is_passed_prematurely{false};
+
+        auto participant{[&]<auto Participant>() {
+            for (unsigned i{0}; i < cycles; ++i)
+            {
+                arrivals++;
+                b.template arrive_and_wait<Participant>();
+                if (arrivals.load() < (i + 1) * 3)
+                    is_passed_prematurely = true;
+                b.template arrive_and_wait<Participant>();
+            }
+        }};
+
+        auto t1{get_thread_for_test_run()};
+        auto t2{get_thread_for_test_run()};
+        t1.start([&]() { participant.template operator()<Event::e1>(); });
+        t2.start([&]() { participant.template operator()<Event::e2>(); });
+        participant.template operator()<Event::e3>();
+
+        t1.join();
+        t2.join();
+
+        REQUIRE(arrivals == cycles * 3);
+        REQUIRE_FALSE(is_passed_prematurely);
+    }
+}
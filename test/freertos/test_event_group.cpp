@@ -332,3 +332,183 @@ TEST_CASE("Event groups are awaited with timeout", "[EventGroup][EventGroupWaitT
         twaiter.join();
     }
 }
+
+TEST_CASE("Event groups are awaited for any or all of the events", "[EventGroup][EventGroupWaitAnyAll]")
+{
+    EventGroup32 eg;
+
+    SECTION("Receives all the set events at once and clears them")
+    {
+        eg.set<Event::e1, Event::e16, Event::e24>();
+
+        auto events{eg.wait_any<Event::e2, Event::e16, Event::e24>()};
+        std::vector<Event> received(events.begin(), events.end());
+        REQUIRE(received == std::vector<Event>{Event::e16, Event::e24});
+        REQUIRE(eg.get() == 0b1);
+    }
+
+    SECTION("Returns an empty set on timeout")
+    {
+        eg.set<Event::e1>();
+        REQUIRE(eg.wait_any<Event::e2, Event::e16>(std::chrono::milliseconds{10}).empty());
+        REQUIRE(eg.get() == 0b1);
+    }
+
+    SECTION("Waits for all the events and clears them")
+    {
+        eg.set<Event::e2>();
+        REQUIRE_FALSE(eg.wait_all<Event::e2, Event::e23>(std::chrono::milliseconds{10}));
+        REQUIRE(eg.get() == 0b10);
+
+        auto twaiter{get_thread_for_test_run()};
+        twaiter.start([&]() { eg.set<Event::e23, Event::e1>(); });
+
+        eg.wait_all<Event::e2, Event::e23>();
+        REQUIRE(eg.get() == 0b1);
+
+        twaiter.join();
+    }
+
+    SECTION("Each event is received by a single waiter")
+    {
+        Event received1, received2;
+        auto t1{get_thread_for_test_run()};
+        auto t2{get_thread_for_test_run()};
+        t1.start([&]() { received1 = eg.wait_one<Event::e1, Event::e2>(); });
+        t2.start([&]() { received2 = eg.wait_one<Event::e1, Event::e2>(); });
+
+        eg.set<Event::e1>();
+        eg.set<Event::e2>();
+        t1.join();
+        t2.join();
+
+        REQUIRE(received1 != received2);
+        REQUIRE(eg.get() == 0);
+    }
+}
+
+TEST_CASE("Event groups pick the received event according to the selection policy", "[EventGroup][EventGroupSelection]")
+{
+    SECTION("Lowest event first by default")
+    {
+        EventGroup32 eg;
+        eg.set<Event::e1, Event::e2>();
+        REQUIRE(eg.wait_one<Event::e1, Event::e2>() == Event::e1);
+        eg.set<Event::e1>();
+        REQUIRE(eg.wait_one<Event::e1, Event::e2>() == Event::e1);
+        REQUIRE(eg.wait_one<Event::e1, Event::e2>() == Event::e2);
+    }
+
+    SECTION("Round robin doesn't starve the events with higher values")
+    {
+        basic_event_group<selection::round_robin, Event::e1, Event::e2, Event::e3> eg;
+        eg.set<Event::e1, Event::e2, Event::e3>();
+
+        REQUIRE(eg.wait_one<Event::e1, Event::e2, Event::e3>() == Event::e1);
+        eg.set<Event::e1>();
+        REQUIRE(eg.wait_one<Event::e1, Event::e2, Event::e3>() == Event::e2);
+        eg.set<Event::e1, Event::e2>();
+        REQUIRE(eg.wait_one<Event::e1, Event::e2, Event::e3>() == Event::e3);
+        REQUIRE(eg.wait_one<Event::e1, Event::e2, Event::e3>() == Event::e1);
+        REQUIRE(eg.wait_one<Event::e1, Event::e2, Event::e3>() == Event::e2);
+    }
+
+    SECTION("Round robin moves on only after the picked event is taken")
+    {
+        selection::round_robin policy;
+        REQUIRE(policy.select(0b11) == 0b01);
+        REQUIRE(policy.select(0b11) == 0b01);
+        policy.on_taken(0b01);
+        REQUIRE(policy.select(0b11) == 0b10);
+        policy.on_taken(0b10);
+        REQUIRE(policy.select(0b11) == 0b01);
+    }
+
+    SECTION("Events are picked by the declared priority")
+    {
+        basic_event_group<selection::by_priority<Event::e3, Event::e1>, Event::e1, Event::e2, Event::e3, Event::e4> eg;
+        eg.set<Event::e1, Event::e2, Event::e3, Event::e4>();
+
+        REQUIRE(eg.wait_one<Event::e1, Event::e2, Event::e3, Event::e4>() == Event::e3);
+        REQUIRE(eg.wait_one<Event::e1, Event::e2, Event::e3, Event::e4>() == Event::e1);
+        REQUIRE(eg.wait_one<Event::e1, Event::e2, Event::e3, Event::e4>() == Event::e2);
+        REQUIRE(eg.wait_one<Event::e1, Event::e2, Event::e3, Event::e4>() == Event::e4);
+    }
+}
+
+#if defined(configTICK_TYPE_WIDTH_IN_BITS) && configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_64_BITS
+
+//! More events than fit in the event group on the ports with 32-bit ticks, up to the highest of the 56 event bits.
+using EventGroup64 = event_group<Event::e32,
+                                 Event::e33,
+                                 Event::e34,
+                                 Event::e35,
+                                 Event::e36,
+                                 Event::e37,
+                                 Event::e38,
+                                 Event::e39,
+                                 Event::e40,
+                                 Event::e41,
+                                 Event::e42,
+                                 Event::e43,
+                                 Event::e44,
+                                 Event::e45,
+                                 Event::e46,
+                                 Event::e47,
+                                 Event::e48,
+                                 Event::e49,
+                                 Event::e50,
+                                 Event::e51,
+                                 Event::e52,
+                                 Event::e53,
+                                 Event::e54,
+                                 Event::e55,
+                                 Event::e56>;
+
+TEST_CASE("Event groups use the event bits above bit 31 on the ports with 64-bit ticks", "[EventGroup][EventGroup64]")
+{
+    static_assert(std::is_same_v<Bits, std::uint64_t>);
+    static_assert(detail::max_event_bits() == 56);
+
+    EventGroup64 eg;
+
+    SECTION("Sets and clears the bits")
+    {
+        eg.set<Event::e32, Event::e33, Event::e56>();
+        REQUIRE(eg.get() == ((Bits{1} << 31) | (Bits{1} << 32) | (Bits{1} << 55)));
+
+        eg.clear<Event::e33>();
+        REQUIRE(eg.get() == ((Bits{1} << 31) | (Bits{1} << 55)));
+    }
+
+    SECTION("Receives the events one by one")
+    {
+        eg.set<Event::e40, Event::e56>();
+        REQUIRE(eg.wait_one<Event::e32, Event::e40, Event::e56>() == Event::e40);
+        REQUIRE(eg.wait_one<Event::e32, Event::e40, Event::e56>() == Event::e56);
+        REQUIRE_FALSE(eg.wait_one<Event::e32, Event::e40, Event::e56>(std::chrono::milliseconds{10}));
+    }
+
+    SECTION("Receives all the set events at once")
+    {
+        eg.set<Event::e32, Event::e48, Event::e55>();
+
+        auto events{eg.wait_any<Event::e33, Event::e48, Event::e55>()};
+        std::vector<Event> received(events.begin(), events.end());
+        REQUIRE(received == std::vector<Event>{Event::e48, Event::e55});
+        REQUIRE(eg.get() == (Bits{1} << 31));
+    }
+
+    SECTION("Waits for all the events")
+    {
+        auto twaiter{get_thread_for_test_run()};
+        twaiter.start([&]() { eg.set<Event::e34, Event::e56>(); });
+
+        REQUIRE(eg.wait_all<Event::e34, Event::e56>(std::chrono::milliseconds{100}));
+        REQUIRE(eg.get() == 0);
+
+        twaiter.join();
+    }
+}
+
+#endif
@@ -0,0 +1,168 @@
+/**
+ * @file        test_isr_to_task_queue.cpp
+ * @brief       Tests the lock-free queue passing elements from an ISR to a task.
+ *
+ * There are no interrupts on the POSIX port, so the ISR is played by the test task itself, or by another task.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "jungles_os_helpers/freertos/isr_to_task_queue.hpp"
+
+#include "platform_utils.hpp"
+#include "thread_under_test_definition.hpp"
+
+using namespace jungles::freertos;
+
+//! Appends to the vector, but throws instead of writing the element when no more writes are allowed.
+struct throwing_output
+{
+    using difference_type = std::ptrdiff_t;
+
+    throwing_output& operator*()
+    {
+        return *this;
+    }
+
+    throwing_output& operator++()
+    {
+        return *this;
+    }
+
+    throwing_output operator++(int)
+    {
+        return *this;
+    }
+
+    throwing_output& operator=(std::string&& elem)
+    {
+        if (*allowed_writes == 0)
+            throw std::runtime_error{"Output is full"};
+        --*allowed_writes;
+        received->push_back(std::move(elem));
+        return *this;
+    }
+
+    std::vector<std::string>* received;
+    unsigned* allowed_writes;
+};
+
+TEST_CASE("ISR to task queue passes elements", "[IsrToTaskQueue]")
+{
+    isr_to_task_queue<std::string, 4> q;
+
+    SECTION("Elements are received in order")
+    {
+        REQUIRE(q.send_from_isr("1"));
+        REQUIRE(q.send_from_isr("2"));
+        REQUIRE(q.receive(0).value() == "1");
+        REQUIRE(q.receive() == "2");
+        REQUIRE_FALSE(q.receive(0).has_value());
+    }
+
+    SECTION("Elements keep their order when the indices wrap around the ring")
+    {
+        unsigned next_to_send{0}, next_to_receive{0};
+        for (unsigned lap{0}; lap < 10; ++lap)
+        {
+            for (unsigned i{0}; i < 3; ++i)
+                REQUIRE(q.send_from_isr(std::to_string(next_to_send++)));
+            for (unsigned i{0}; i < 3; ++i)
+                REQUIRE(q.receive(0).value() == std::to_string(next_to_receive++));
+        }
+        REQUIRE_FALSE(q.receive(0).has_value());
+    }
+
+    SECTION("Full ring rejects the element and leaves it intact")
+    {
+        REQUIRE(q.send_from_isr("1"));
+        REQUIRE(q.send_from_isr("2"));
+        REQUIRE(q.send_from_isr("3"));
+        REQUIRE(q.send_from_isr("4"));
+
+        std::string rejected{"5"};
+        REQUIRE_FALSE(q.send_from_isr(std::move(rejected)));
+        REQUIRE(rejected == "5");
+
+        REQUIRE(q.receive(0).value() == "1");
+        REQUIRE(q.send_from_isr(std::move(rejected)));
+
+        std::vector<std::string> received;
+        REQUIRE(q.receive_many(std::back_inserter(received), 8, 0) == 4);
+        REQUIRE(received == std::vector<std::string>{"2", "3", "4", "5"});
+    }
+
+    SECTION("Consumer is notified only when the ring becomes non-empty")
+    {
+        // Registers the test task as the consumer.
+        REQUIRE_FALSE(q.receive(0).has_value());
+        ulTaskNotifyTake(pdTRUE, 0);
+
+        REQUIRE(q.send_from_isr("1"));
+        REQUIRE(q.send_from_isr("2"));
+        REQUIRE(q.send_from_isr("3"));
+        REQUIRE(ulTaskNotifyTake(pdTRUE, 0) == 1);
+
+        std::vector<std::string> received;
+        REQUIRE(q.receive_many(std::back_inserter(received), 8, 0) == 3);
+
+        REQUIRE(q.send_from_isr("4"));
+        REQUIRE(ulTaskNotifyTake(pdTRUE, 0) == 1);
+        REQUIRE(q.receive(0).value() == "4");
+    }
+
+    SECTION("Blocked consumer is woken up by the ISR")
+    {
+        auto t{get_thread_for_test_run()};
+        t.start([&]() {
+            utils::delay(std::chrono::milliseconds{10});
+            q.send_from_isr("1");
+            utils::delay(std::chrono::milliseconds{10});
+            q.send_from_isr("2");
+        });
+
+        REQUIRE(q.receive() == "1");
+        REQUIRE(q.receive(1000).value() == "2");
+
+        t.join();
+    }
+
+    SECTION("Blocked receive_many returns as soon as an element arrives")
+    {
+        auto t{get_thread_for_test_run()};
+        t.start([&]() {
+            utils::delay(std::chrono::milliseconds{10});
+            q.send_from_isr("1");
+        });
+
+        std::vector<std::string> received;
+        REQUIRE(q.receive_many(std::back_inserter(received), 4) == 1);
+        REQUIRE(received == std::vector<std::string>{"1"});
+
+        t.join();
+    }
+
+    SECTION("Elements taken before the output iterator throws are not received again")
+    {
+        REQUIRE(q.send_from_isr("1"));
+        REQUIRE(q.send_from_isr("2"));
+        REQUIRE(q.send_from_isr("3"));
+
+        std::vector<std::string> received;
+        unsigned allowed_writes{1};
+        REQUIRE_THROWS_AS(q.receive_many(throwing_output{&received, &allowed_writes}, 3, 0), std::runtime_error);
+        REQUIRE(received == std::vector<std::string>{"1"});
+
+        // The element which failed to be written out is lost.
+        REQUIRE(q.receive(0).value() == "3");
+        REQUIRE_FALSE(q.receive(0).has_value());
+    }
+}
@@ -0,0 +1,94 @@
+/**
+ * @file        test_queue_selector.cpp
+ * @brief       Tests waiting on multiple FreeRTOS queues at once.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+#include "jungles_os_helpers/freertos/queue.hpp"
+#include "jungles_os_helpers/freertos/queue_selector.hpp"
+
+#include "platform_utils.hpp"
+#include "thread_under_test_definition.hpp"
+
+using namespace jungles::freertos;
+using jungles::generic::select_order;
+
+TEST_CASE("Queue selector tells which queue is ready", "[QueueSelector]")
+{
+    queue<std::string, 4> strings;
+    queue<int, 4> ints;
+
+    SECTION("Times out when no queue is ready")
+    {
+        queue_selector selector{strings, ints};
+        REQUIRE_FALSE(selector.wait(10).has_value());
+    }
+
+    SECTION("Returns the queue which has an element")
+    {
+        queue_selector selector{strings, ints};
+        ints.send(5);
+
+        REQUIRE(selector.wait() == 1);
+        REQUIRE(ints.receive(0).value() == 5);
+    }
+
+    SECTION("Notices the elements sent before the selector was created")
+    {
+        strings.send("1");
+        queue_selector selector{strings, ints};
+
+        REQUIRE(selector.wait(0) == 0);
+        REQUIRE(strings.receive(0).value() == "1");
+    }
+
+    SECTION("Wakes up when an element is sent from another task")
+    {
+        queue_selector selector{strings, ints};
+
+        auto t{get_thread_for_test_run()};
+        t.start([&]() {
+            utils::delay(std::chrono::milliseconds{10});
+            strings.send("1");
+        });
+
+        REQUIRE(selector.wait(1000) == 0);
+        REQUIRE(strings.receive(0).value() == "1");
+
+        t.join();
+    }
+
+    SECTION("Serves the queues by priority")
+    {
+        queue_selector selector{select_order::priority, strings, ints};
+        ints.send(1);
+        strings.send("1");
+        strings.send("2");
+
+        REQUIRE(selector.wait(0) == 0);
+        strings.receive(0);
+        REQUIRE(selector.wait(0) == 0);
+        strings.receive(0);
+        REQUIRE(selector.wait(0) == 1);
+        ints.receive(0);
+        REQUIRE_FALSE(selector.wait(0).has_value());
+    }
+
+    SECTION("Serves the queues in round-robin fashion")
+    {
+        queue_selector selector{select_order::round_robin, strings, ints};
+        strings.send("1");
+        strings.send("2");
+        ints.send(1);
+
+        REQUIRE(selector.wait(0) == 0);
+        strings.receive(0);
+        REQUIRE(selector.wait(0) == 1);
+        ints.receive(0);
+        REQUIRE(selector.wait(0) == 0);
+        strings.receive(0);
+        REQUIRE_FALSE(selector.wait(0).has_value());
+    }
+}
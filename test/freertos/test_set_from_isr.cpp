@@ -0,0 +1,151 @@
+/**
+ * @file        test_set_from_isr.cpp
+ * @brief       Tests setting the event groups and the flags from an ISR.
+ *
+ * There are no interrupts on the POSIX port, so the ISR is played by the test task itself, or by another task.
+ * event_group and flag defer the setting to the timer daemon task, while single_waiter_event_group sets the events
+ * in the ISR itself. With the scheduler suspended the timer daemon doesn't run, so the deferred setting is held in
+ * the timer command queue until the scheduler is resumed.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <chrono>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "../event_enum.hpp"
+#include "jungles_os_helpers/freertos/event_group.hpp"
+#include "jungles_os_helpers/freertos/flag.hpp"
+#include "jungles_os_helpers/freertos/single_waiter_event_group.hpp"
+
+#include "platform_utils.hpp"
+#include "thread_under_test_definition.hpp"
+
+using namespace jungles::freertos;
+using namespace test_helpers;
+
+TEST_CASE("Event groups are set from ISR", "[SetFromIsr][EventGroup]")
+{
+    event_group<Event::e1, Event::e2, Event::e3> eg;
+
+    SECTION("Events are set by the timer daemon task")
+    {
+        vTaskSuspendAll();
+        auto is_deferred{eg.set_from_isr<Event::e1, Event::e3>()};
+        auto bits_before_daemon_runs{eg.get()};
+        xTaskResumeAll();
+
+        REQUIRE(is_deferred);
+        REQUIRE(bits_before_daemon_runs == 0);
+        REQUIRE(eg.wait_all<Event::e1, Event::e3>(std::chrono::milliseconds{100}));
+    }
+
+    SECTION("Blocked waiter is woken up")
+    {
+        bool is_set{false};
+        auto t{get_thread_for_test_run()};
+        t.start([&]() {
+            utils::delay(std::chrono::milliseconds{10});
+            is_set = eg.set_from_isr<Event::e2>();
+        });
+
+        REQUIRE(eg.wait_one<Event::e1, Event::e2>(std::chrono::milliseconds{100}) == Event::e2);
+        t.join();
+        REQUIRE(is_set);
+    }
+
+    SECTION("Events are not set when the timer command queue is full")
+    {
+        std::array<bool, configTIMER_QUEUE_LENGTH + 1> results;
+
+        vTaskSuspendAll();
+        for (auto& r : results)
+            r = eg.set_from_isr<Event::e1>();
+        xTaskResumeAll();
+
+        for (unsigned i{0}; i < configTIMER_QUEUE_LENGTH; ++i)
+            REQUIRE(results[i]);
+        REQUIRE_FALSE(results.back());
+
+        utils::delay(std::chrono::milliseconds{10});
+        REQUIRE(eg.set_from_isr<Event::e2>());
+        REQUIRE(eg.wait_all<Event::e1, Event::e2>(std::chrono::milliseconds{100}));
+    }
+}
+
+TEST_CASE("Flags are set from ISR", "[SetFromIsr][Flag]")
+{
+    SECTION("Flag is set by the timer daemon task")
+    {
+        flag f;
+
+        vTaskSuspendAll();
+        auto is_deferred{f.set_from_isr()};
+        xTaskResumeAll();
+
+        REQUIRE(is_deferred);
+        REQUIRE(f.wait_for(std::chrono::milliseconds{100}));
+    }
+
+    SECTION("Blocked waiter is woken up by the auto-reset flag")
+    {
+        auto_reset_flag f;
+        bool is_set{false};
+        auto t{get_thread_for_test_run()};
+        t.start([&]() {
+            utils::delay(std::chrono::milliseconds{10});
+            is_set = f.set_from_isr();
+        });
+
+        REQUIRE(f.wait_for(std::chrono::milliseconds{100}));
+        t.join();
+        REQUIRE(is_set);
+        REQUIRE_FALSE(f.wait_for(std::chrono::milliseconds{0}));
+    }
+
+    SECTION("Flag is not set when the timer command queue is full")
+    {
+        flag f;
+        event_group<Event::e1> eg;
+
+        vTaskSuspendAll();
+        for (unsigned i{0}; i < configTIMER_QUEUE_LENGTH; ++i)
+            eg.set_from_isr<Event::e1>();
+        auto is_deferred{f.set_from_isr()};
+        xTaskResumeAll();
+
+        REQUIRE_FALSE(is_deferred);
+        utils::delay(std::chrono::milliseconds{10});
+        REQUIRE_FALSE(f.wait_for(std::chrono::milliseconds{0}));
+    }
+}
+
+TEST_CASE("Single waiter event groups are set from ISR", "[SetFromIsr][SingleWaiterEventGroup]")
+{
+    single_waiter_event_group<Event::e1, Event::e2, Event::e3> eg;
+
+    SECTION("Events are set in the ISR itself")
+    {
+        vTaskSuspendAll();
+        eg.set_from_isr<Event::e1, Event::e3>();
+        auto bits{eg.get()};
+        xTaskResumeAll();
+
+        REQUIRE(bits == 0b101);
+    }
+
+    SECTION("Blocked waiter is woken up")
+    {
+        auto t{get_thread_for_test_run()};
+        t.start([&]() {
+            utils::delay(std::chrono::milliseconds{10});
+            eg.set_from_isr<Event::e2>();
+        });
+
+        REQUIRE(eg.wait_one<Event::e1, Event::e2>(std::chrono::milliseconds{100}) == Event::e2);
+        t.join();
+        REQUIRE(eg.get() == 0);
+    }
+}
@@ -0,0 +1,107 @@
+/**
+ * @file        test_single_consumer_queue.cpp
+ * @brief       Tests the FreeRTOS queue which wakes up its single consumer with task notifications.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "jungles_os_helpers/freertos/single_consumer_queue.hpp"
+
+#include "platform_utils.hpp"
+#include "thread_under_test_definition.hpp"
+
+using namespace jungles::freertos;
+
+TEST_CASE("Single consumer queue passes elements", "[SingleConsumerQueue]")
+{
+    single_consumer_queue<std::string, 4> q;
+
+    SECTION("Elements are received in order")
+    {
+        q.send("1");
+        q.send("2");
+        q.send("3");
+        REQUIRE(q.receive(0).value() == "1");
+        REQUIRE(q.receive() == "2");
+        REQUIRE(q.receive(0).value() == "3");
+    }
+
+    SECTION("Times out when empty")
+    {
+        REQUIRE_FALSE(q.receive(10).has_value());
+    }
+
+    SECTION("Throws when full")
+    {
+        q.send("1");
+        q.send("2");
+        q.send("3");
+        q.send("4");
+        REQUIRE_THROWS_AS(q.send("5"), decltype(q)::queue_full_error);
+    }
+
+    SECTION("Receives up to the requested number of elements at once")
+    {
+        q.send("1");
+        q.send("2");
+        q.send("3");
+
+        std::vector<std::string> received;
+        REQUIRE(q.receive_many(std::back_inserter(received), 2, 0) == 2);
+        REQUIRE(q.receive_many(std::back_inserter(received), 2, 0) == 1);
+        REQUIRE(received == std::vector<std::string>{"1", "2", "3"});
+    }
+
+    SECTION("Blocked consumer is woken up by a producer task")
+    {
+        auto t{get_thread_for_test_run()};
+        t.start([&]() {
+            utils::delay(std::chrono::milliseconds{10});
+            q.send("1");
+            utils::delay(std::chrono::milliseconds{10});
+            q.send("2");
+        });
+
+        REQUIRE(q.receive(1000).value() == "1");
+        REQUIRE(q.receive(1000).value() == "2");
+
+        t.join();
+    }
+
+    SECTION("Timed send times out when full and leaves the element intact")
+    {
+        for (auto e : {"1", "2", "3", "4"})
+            REQUIRE(q.try_send(e));
+
+        std::string rejected{"5"};
+        REQUIRE_FALSE(q.send(std::move(rejected), 10));
+        REQUIRE(rejected == "5");
+    }
+
+    SECTION("Blocked producers are woken up once the consumer frees space")
+    {
+        for (auto e : {"1", "2", "3", "4"})
+            REQUIRE(q.try_send(e));
+
+        bool is_sent1{false}, is_sent2{false};
+        auto t1{get_thread_for_test_run()};
+        auto t2{get_thread_for_test_run()};
+        t1.start([&]() { is_sent1 = q.send("5", 1000); });
+        t2.start([&]() { is_sent2 = q.send("5", 1000); });
+        utils::delay(std::chrono::milliseconds{10});
+
+        std::vector<std::string> received;
+        REQUIRE(q.receive_many(std::back_inserter(received), 4, 0) == 4);
+        t1.join();
+        t2.join();
+
+        REQUIRE(is_sent1);
+        REQUIRE(is_sent2);
+        REQUIRE(q.receive_many(std::back_inserter(received), 4, 0) == 2);
+        REQUIRE(received == std::vector<std::string>{"1", "2", "3", "4", "5", "5"});
+    }
+}
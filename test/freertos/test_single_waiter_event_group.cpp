@@ -0,0 +1,74 @@
+/**
+ * @file        test_single_waiter_event_group.cpp
+ * @brief       Tests the FreeRTOS event group which wakes up its single waiter with task notifications.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <vector>
+
+#include "../event_enum.hpp"
+#include "jungles_os_helpers/freertos/single_waiter_event_group.hpp"
+
+#include "platform_utils.hpp"
+#include "thread_under_test_definition.hpp"
+
+using namespace jungles::freertos;
+using namespace test_helpers;
+
+TEST_CASE("Single waiter event group passes events", "[SingleWaiterEventGroup]")
+{
+    single_waiter_event_group<Event::e1, Event::e2, Event::e16, Event::e24> eg;
+
+    SECTION("Sets and clears the events")
+    {
+        eg.set<Event::e2, Event::e24>();
+        REQUIRE(eg.get() == 0b100000000000000000000010);
+
+        eg.clear<Event::e24>();
+        REQUIRE(eg.get() == 0b10);
+    }
+
+    SECTION("Gets each event one by one")
+    {
+        eg.set<Event::e16, Event::e2>();
+        REQUIRE(eg.wait_one<Event::e2, Event::e16>() == Event::e2);
+        REQUIRE(eg.wait_one<Event::e2, Event::e16>() == Event::e16);
+        REQUIRE(eg.get() == 0);
+    }
+
+    SECTION("Times out when only the other events are set")
+    {
+        eg.set<Event::e1>();
+        REQUIRE_FALSE(eg.wait_one<Event::e2, Event::e16>(std::chrono::milliseconds{10}).has_value());
+        REQUIRE(eg.wait_any<Event::e2, Event::e16>(std::chrono::milliseconds{10}).empty());
+        REQUIRE_FALSE(eg.wait_all<Event::e1, Event::e2>(std::chrono::milliseconds{10}));
+        REQUIRE(eg.get() == 0b1);
+    }
+
+    SECTION("Receives all the set events at once")
+    {
+        eg.set<Event::e1, Event::e16, Event::e24>();
+
+        auto events{eg.wait_any<Event::e2, Event::e16, Event::e24>()};
+        std::vector<Event> received(events.begin(), events.end());
+        REQUIRE(received == std::vector<Event>{Event::e16, Event::e24});
+        REQUIRE(eg.get() == 0b1);
+    }
+
+    SECTION("Blocked waiter is woken up by a setter task")
+    {
+        auto t{get_thread_for_test_run()};
+        t.start([&]() {
+            utils::delay(std::chrono::milliseconds{10});
+            eg.set<Event::e2>();
+            utils::delay(std::chrono::milliseconds{10});
+            eg.set<Event::e24>();
+        });
+
+        eg.wait_all<Event::e2, Event::e24>();
+        REQUIRE(eg.get() == 0);
+
+        t.join();
+    }
+}
@@ -0,0 +1,79 @@
+/**
+ * @file        test_static_thread.cpp
+ * @brief       Tests the FreeRTOS thread which doesn't use the heap.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <chrono>
+
+#include "jungles_os_helpers/freertos/static_thread.hpp"
+
+#include "platform_utils.hpp"
+#include "test_helpers.hpp"
+
+using namespace jungles::freertos;
+
+TEST_CASE("Static thread runs thread code", "[StaticThread]")
+{
+    static_thread<512> t{"Static_thread", 1};
+
+    SECTION("Thread code is run and joined")
+    {
+        bool was_run{false};
+        t.start([&]() { was_run = true; });
+        t.join();
+        REQUIRE(was_run);
+    }
+
+    SECTION("Captures stored inline are passed to the thread code")
+    {
+        std::array<int, 3> values{1, 2, 3};
+        int sum{0};
+        t.start([values, &sum]() {
+            for (auto v : values)
+                sum += v;
+        });
+        t.join();
+        REQUIRE(sum == 6);
+    }
+
+    SECTION("Detached thread continues running")
+    {
+        test_helpers::flag thread_finished;
+        t.start([&]() { thread_finished.set(); });
+        t.detach();
+        thread_finished.wait();
+    }
+
+    SECTION("Thread which has already finished is detached")
+    {
+        test_helpers::flag thread_finished;
+        t.start([&]() { thread_finished.set(); });
+        thread_finished.wait();
+        utils::delay(std::chrono::milliseconds{10});
+        REQUIRE(t.detach() == decltype(t)::status::ok);
+    }
+
+    SECTION("Joining twice is allowed")
+    {
+        t.start([]() {});
+        t.join();
+        REQUIRE_NOTHROW(t.join());
+    }
+
+    SECTION("Throws when joining a detached thread")
+    {
+        test_helpers::flag thread_finished;
+        t.start([&]() { thread_finished.set(); });
+        t.detach();
+        REQUIRE_THROWS_AS(t.join(), decltype(t)::already_detached_error);
+        thread_finished.wait();
+    }
+
+    SECTION("Throws when not started")
+    {
+        REQUIRE_THROWS_AS(t.join(), decltype(t)::not_started_error);
+        REQUIRE_THROWS_AS(t.detach(), decltype(t)::not_started_error);
+    }
+}
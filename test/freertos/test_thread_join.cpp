@@ -0,0 +1,63 @@
+/**
+ * @file        test_thread_join.cpp
+ * @brief       Tests that joining the FreeRTOS threads leaves the notification value of the joining task intact.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "jungles_os_helpers/freertos/static_thread.hpp"
+#include "jungles_os_helpers/freertos/thread.hpp"
+
+#include "platform_utils.hpp"
+
+using namespace jungles::freertos;
+
+template<typename MakeAndJoinThread>
+static void require_no_notification_pending_after_joins(MakeAndJoinThread make_and_join_thread)
+{
+    // Both the thread which finishes right away and the one which finishes while the joiner is blocked.
+    for (unsigned i{0}; i < 100; ++i)
+    {
+        make_and_join_thread(i % 2 == 0 ? std::chrono::milliseconds{0} : std::chrono::milliseconds{1});
+        REQUIRE(ulTaskNotifyTake(pdTRUE, 0) == 0);
+    }
+}
+
+TEST_CASE("Joining a thread leaves no notification pending", "[ThreadJoin]")
+{
+    SECTION("Thread")
+    {
+        auto make_and_join_thread{[](std::chrono::milliseconds duration) {
+            thread t{"Join_thread", 512, 1};
+            t.start([duration]() { utils::delay(duration); });
+            t.join();
+        }};
+        require_no_notification_pending_after_joins(make_and_join_thread);
+    }
+
+    SECTION("Static thread")
+    {
+        auto make_and_join_thread{[](std::chrono::milliseconds duration) {
+            static_thread<512> t{"Join_thread", 1};
+            t.start([duration]() { utils::delay(duration); });
+            t.join();
+        }};
+        require_no_notification_pending_after_joins(make_and_join_thread);
+    }
+
+    SECTION("Joining task woken up by another notifier consumes the notification of the finishing task")
+    {
+        auto joiner{xTaskGetCurrentTaskHandle()};
+        thread t{"Join_thread", 512, 1};
+        t.start([joiner]() {
+            xTaskNotifyGive(joiner);
+            utils::delay(std::chrono::milliseconds{10});
+        });
+        t.join();
+        REQUIRE(ulTaskNotifyTake(pdTRUE, 0) == 0);
+    }
+}
@@ -0,0 +1,93 @@
+/**
+ * @file        test_thread_stats.cpp
+ * @brief       Tests the statistics of the FreeRTOS threads.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include "jungles_os_helpers/freertos/static_thread.hpp"
+#include "jungles_os_helpers/freertos/thread.hpp"
+#include "jungles_os_helpers/freertos/thread_pool.hpp"
+
+#include "test_helpers.hpp"
+
+using namespace jungles::freertos;
+
+template<typename Thread>
+static void require_stats_of_running_and_finished_thread(Thread& t, std::size_t stack_size)
+{
+    test_helpers::flag thread_started;
+    test_helpers::flag may_finish;
+    t.start([&]() {
+        thread_started.set();
+        may_finish.wait();
+    });
+    thread_started.wait();
+
+    auto s{t.stats()};
+    REQUIRE(s.state != eDeleted);
+    REQUIRE(s.state != eInvalid);
+    REQUIRE(s.stack_high_water_mark > 0);
+    REQUIRE(s.stack_high_water_mark < stack_size);
+
+    may_finish.set();
+    t.join();
+    REQUIRE(t.stats().state == eDeleted);
+}
+
+TEST_CASE("FreeRTOS threads report their statistics", "[ThreadStats]")
+{
+    SECTION("Thread which is not started has no statistics")
+    {
+        thread t{"Stats_thread", 512, 1};
+        REQUIRE(t.stats().state == eInvalid);
+    }
+
+    SECTION("Thread reports the stack high-water mark while it runs")
+    {
+        thread t{"Stats_thread", 512, 1};
+        require_stats_of_running_and_finished_thread(t, 512);
+    }
+
+    SECTION("Static thread reports the stack high-water mark while it runs")
+    {
+        static_thread<512> t{"Stats_thread", 1};
+        require_stats_of_running_and_finished_thread(t, 512);
+
+        // Sampled right before the task is deleted.
+        REQUIRE(t.stats().stack_high_water_mark > 0);
+    }
+
+    SECTION("Busy thread reports its runtime and CPU share")
+    {
+        test_helpers::flag thread_started;
+        test_helpers::flag busy_loop_finished;
+        test_helpers::flag may_finish;
+        thread t{"Stats_thread", 512, 1};
+        t.start([&]() {
+            thread_started.set();
+            auto start{xTaskGetTickCount()};
+            while (xTaskGetTickCount() - start < pdMS_TO_TICKS(50))
+            {
+            }
+            busy_loop_finished.set();
+            may_finish.wait();
+        });
+        thread_started.wait();
+        t.stats();
+
+        busy_loop_finished.wait();
+        auto s{t.stats()};
+        REQUIRE(s.runtime > 0);
+        REQUIRE(s.cpu_share_permille > 0);
+
+        may_finish.set();
+        t.join();
+    }
+
+    SECTION("Thread pool runners report their statistics")
+    {
+        ::freertos::thread_pool<2, 4, ::freertos::ThreadPoolConfig{512, 1}> pool;
+        REQUIRE(pool.runner(0).stats().stack_high_water_mark > 0);
+        REQUIRE(pool.runner(1).stats().stack_high_water_mark > 0);
+    }
+}
@@ -7,8 +7,11 @@
 #include "test/test_helpers.hpp"
 
 #include "active_under_test_definition.hpp"
+#include "platform_utils.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -35,4 +38,27 @@ TEST_CASE("Active object performs work in background", "[active]")
         REQUIRE(touched2 == true);
         REQUIRE(touched3 == true);
     }
+
+    SECTION("Destruction waits for space in the full mailbox for the quit message")
+    {
+        // Fills the mailbox of the FreeRTOS active, which holds 16 messages, while the first message is handled.
+        constexpr unsigned mailbox_size{16};
+        std::atomic<bool> is_first_message_being_handled{false};
+        std::atomic<unsigned> handled_count{0};
+        {
+            auto a{get_active_object_for_test_run<test_helpers::message>([&](test_helpers::message&& m) {
+                m.callback();
+                ++handled_count;
+            })};
+            a.send(test_helpers::message{[&]() {
+                is_first_message_being_handled = true;
+                utils::delay(std::chrono::milliseconds{100});
+            }});
+            while (!is_first_message_being_handled)
+                utils::delay(std::chrono::milliseconds{1});
+            for (unsigned i{0}; i < mailbox_size; ++i)
+                a.send(test_helpers::message{[]() {}});
+        }
+        REQUIRE(handled_count == mailbox_size + 1);
+    }
 }
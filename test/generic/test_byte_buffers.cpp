@@ -0,0 +1,100 @@
+/**
+ * @file	test_byte_buffers.cpp
+ * @brief	Generic tests of the stream and message buffers.
+ */
+#include "catch2/catch_test_macros.hpp"
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+#include "byte_buffers_under_test_definition.hpp"
+
+namespace
+{
+std::span<const std::byte> as_bytes(std::string_view s)
+{
+    return std::as_bytes(std::span{s.data(), s.size()});
+}
+
+std::string_view as_string(std::span<const std::byte> bytes)
+{
+    return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+}
+} // namespace
+
+TEST_CASE("Stream buffer passes a byte stream", "[stream_buffer]")
+{
+    std::array<std::byte, 16> buffer;
+
+    SECTION("Bytes are read in the order they were written, regardless of the write boundaries")
+    {
+        auto sb{get_stream_buffer_for_test_run<8>()};
+        REQUIRE(sb.send(as_bytes("abc")) == 3);
+        REQUIRE(sb.send(as_bytes("de")) == 2);
+        REQUIRE(sb.bytes_available() == 5);
+
+        auto read{sb.receive(std::span{buffer}.first(4), 0)};
+        REQUIRE(as_string(std::span{buffer}.first(read)) == "abcd");
+        read = sb.receive(buffer, 0);
+        REQUIRE(as_string(std::span{buffer}.first(read)) == "e");
+    }
+
+    SECTION("Only as many bytes as fit are written on timeout")
+    {
+        auto sb{get_stream_buffer_for_test_run<4>()};
+        REQUIRE(sb.send(as_bytes("abcdef"), 10) == 4);
+        REQUIRE(sb.space_available() == 0);
+    }
+
+    SECTION("Bytes below the trigger level are read on timeout")
+    {
+        auto sb{get_stream_buffer_for_test_run<8>(4)};
+        REQUIRE(sb.receive(buffer, 10) == 0);
+
+        sb.send(as_bytes("ab"));
+        REQUIRE(sb.receive(buffer, 10) == 2);
+        REQUIRE_FALSE(sb.set_trigger_level(9));
+    }
+
+    SECTION("Reset drops all the bytes")
+    {
+        auto sb{get_stream_buffer_for_test_run<8>()};
+        sb.send(as_bytes("abc"));
+        REQUIRE(sb.reset());
+        REQUIRE(sb.bytes_available() == 0);
+    }
+}
+
+TEST_CASE("Message buffer keeps the message boundaries", "[message_buffer]")
+{
+    auto mb{get_message_buffer_for_test_run<64>()};
+    std::array<std::byte, 16> buffer;
+
+    SECTION("Each receive gets exactly one message")
+    {
+        REQUIRE(mb.send(as_bytes("first")));
+        REQUIRE(mb.send(as_bytes("second one")));
+
+        REQUIRE(mb.next_message_size() == 5);
+        auto length{mb.receive(buffer, 0)};
+        REQUIRE(as_string(std::span{buffer}.first(length)) == "first");
+        length = mb.receive(buffer, 0);
+        REQUIRE(as_string(std::span{buffer}.first(length)) == "second one");
+        REQUIRE(mb.receive(buffer, 10) == 0);
+    }
+
+    SECTION("Message is left in place when the buffer is too small")
+    {
+        mb.send(as_bytes("long message"));
+        REQUIRE(mb.receive(std::span{buffer}.first(4), 0) == 0);
+        REQUIRE(mb.receive(buffer, 0) == 12);
+    }
+
+    SECTION("Message which can never fit is rejected")
+    {
+        std::array<std::byte, 64> too_big{};
+        REQUIRE_FALSE(mb.send(too_big));
+    }
+}
@@ -5,9 +5,12 @@
  */
 #include "catch2/catch_test_macros.hpp"
 
+#include <atomic>
+#include <chrono>
 #include <thread>
 
 #include "flag_under_test_definition.hpp"
+#include "platform_utils.hpp"
 #include "test/test_helpers.hpp"
 
 TEST_CASE("Flag can be set, reset and waited for", "[flag]")
@@ -86,3 +89,64 @@ TEST_CASE("Flag can be set, reset and waited for", "[flag]")
         REQUIRE(is_waiting_finished);
     }
 }
+
+TEST_CASE("Auto-reset flag is consumed by a wait", "[flag]")
+{
+    auto flag_under_test{get_auto_reset_flag_implementation_under_test()};
+
+    SECTION("Flag is reset after a wait")
+    {
+        flag_under_test.set();
+        flag_under_test.wait();
+
+        REQUIRE_FALSE(flag_under_test.is_set());
+        REQUIRE_FALSE(flag_under_test.wait_for(std::chrono::milliseconds{10}));
+    }
+
+    SECTION("Each set releases a single waiter")
+    {
+        std::thread t1{[&]() { flag_under_test.wait(); }};
+        std::thread t2{[&]() { flag_under_test.wait(); }};
+
+        flag_under_test.set();
+        while (flag_under_test.is_set())
+            std::this_thread::yield();
+        flag_under_test.set();
+
+        t1.join();
+        t2.join();
+
+        REQUIRE_FALSE(flag_under_test.is_set());
+    }
+
+    SECTION("A single set releases only one of the waiting threads")
+    {
+        std::atomic<unsigned> num_released{0};
+        auto waiter{[&]() {
+            flag_under_test.wait();
+            ++num_released;
+        }};
+        std::thread t1{waiter};
+        std::thread t2{waiter};
+        utils::delay(std::chrono::milliseconds{10});
+
+        flag_under_test.set();
+        utils::delay(std::chrono::milliseconds{10});
+        REQUIRE(num_released == 1);
+
+        flag_under_test.set();
+        t1.join();
+        t2.join();
+
+        REQUIRE(num_released == 2);
+        REQUIRE_FALSE(flag_under_test.is_set());
+    }
+
+    SECTION("Reset flag makes wait time out")
+    {
+        flag_under_test.set();
+        flag_under_test.reset();
+
+        REQUIRE_FALSE(flag_under_test.wait_for(std::chrono::milliseconds{10}));
+    }
+}
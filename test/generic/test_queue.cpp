@@ -5,10 +5,14 @@
  */
 #include "catch2/catch_test_macros.hpp"
 
+#include <array>
 #include <future>
 #include <iostream>
+#include <iterator>
 #include <thread>
+#include <vector>
 
+#include "platform_utils.hpp"
 #include "queue_under_test_definition.hpp"
 #include "thread_under_test_definition.hpp"
 
@@ -39,6 +43,44 @@ TEST_CASE("Messages are received and sent to the queue", "[queue]")
             REQUIRE(q.receive(0).value() == "3");
         }
     }
+    SECTION("Messages are sent and received in batches")
+    {
+        SECTION("Whole batch is received at once")
+        {
+            std::vector<std::string> batch{"1", "2", "3"};
+            q.send_many(batch);
+
+            std::vector<std::string> received;
+            REQUIRE(q.receive_many(std::back_inserter(received), 4, 0) == 3);
+            REQUIRE(received == std::vector<std::string>{"1", "2", "3"});
+        }
+        SECTION("No more messages than requested are received")
+        {
+            std::vector<std::string> batch{"1", "2", "3"};
+            q.send_many(batch);
+
+            std::vector<std::string> received;
+            REQUIRE(q.receive_many(std::back_inserter(received), 2, 0) == 2);
+            REQUIRE(received == std::vector<std::string>{"1", "2"});
+            REQUIRE(q.receive(0).value() == "3");
+        }
+        SECTION("Batch which doesn't fit is not sent at all")
+        {
+            q.send("1");
+            q.send("2");
+            std::vector<std::string> batch{"3", "4", "5"};
+            REQUIRE_THROWS(q.send_many(batch));
+            REQUIRE(q.receive(0).value() == "1");
+            REQUIRE(q.receive(0).value() == "2");
+            REQUIRE(!q.receive(0).has_value());
+        }
+        SECTION("Timeout occured when receiving a batch from an empty queue")
+        {
+            std::vector<std::string> received;
+            REQUIRE(q.receive_many(std::back_inserter(received), 4, 10) == 0);
+            REQUIRE(received.empty());
+        }
+    }
     SECTION("Timeout occured when receiving from an empty queue")
     {
         REQUIRE(!q.receive(300).has_value());
@@ -81,3 +123,248 @@ TEST_CASE("Messages are received and sent to the queue", "[queue]")
         }
     }
 }
+
+namespace
+{
+//! Not default-constructible, and counts its live instances, including the moved-from ones.
+struct tracked_element
+{
+    explicit tracked_element(int value) : value{value}
+    {
+        ++num_alive;
+    }
+
+    tracked_element(const tracked_element& other) : value{other.value}
+    {
+        ++num_alive;
+    }
+
+    tracked_element(tracked_element&& other) noexcept : value{other.value}
+    {
+        ++num_alive;
+    }
+
+    tracked_element& operator=(const tracked_element&) = default;
+    tracked_element& operator=(tracked_element&&) noexcept = default;
+
+    ~tracked_element()
+    {
+        --num_alive;
+    }
+
+    int value;
+    static inline int num_alive{0};
+};
+} // namespace
+
+TEST_CASE("Elements live in the queue only between sending and receiving", "[queue]")
+{
+    auto q{get_queue_object_for_test_run<tracked_element, 4>()};
+    REQUIRE(tracked_element::num_alive == 0);
+
+    SECTION("Queue holds non-default-constructible elements")
+    {
+        q.send(tracked_element{1});
+        REQUIRE(q.receive(0).value().value == 1);
+    }
+
+    SECTION("Received element is destroyed right away")
+    {
+        q.send(tracked_element{1});
+        REQUIRE(tracked_element::num_alive == 1);
+
+        q.receive(0);
+        REQUIRE(tracked_element::num_alive == 0);
+    }
+}
+
+TEST_CASE("Elements left in the queue are destroyed with it", "[queue]")
+{
+    {
+        auto q{get_queue_object_for_test_run<tracked_element, 4>()};
+        q.send(tracked_element{1});
+        q.send(tracked_element{2});
+        REQUIRE(tracked_element::num_alive == 2);
+    }
+    REQUIRE(tracked_element::num_alive == 0);
+}
+
+TEST_CASE("Elements are filled and read in place", "[queue]")
+{
+    using frame = std::array<char, 512>;
+    auto q{get_queue_object_for_test_run<frame, 4>()};
+
+    SECTION("Reserved element is received after it is committed")
+    {
+        auto f{q.reserve()};
+        f->fill('a');
+        REQUIRE_FALSE(q.receive(0).has_value());
+        f.commit();
+
+        REQUIRE(q.receive(0).value()[511] == 'a');
+    }
+
+    SECTION("Peeked element is removed on release")
+    {
+        auto b{q.reserve()};
+        b->fill('b');
+        b.commit();
+        auto c{q.reserve()};
+        c->fill('c');
+        c.commit();
+
+        REQUIRE((**q.peek(0))[0] == 'b');
+        auto m{q.peek()};
+        REQUIRE((*m)[0] == 'c');
+        m.release();
+        REQUIRE_FALSE(q.peek(0).has_value());
+    }
+
+    SECTION("Elements are published in the order of their reservations")
+    {
+        auto first{q.reserve()};
+        auto second{q.reserve()};
+        second->fill('2');
+        second.commit();
+        q.send(frame{});
+        REQUIRE_FALSE(q.peek(0).has_value());
+
+        first->fill('1');
+        first.commit();
+        REQUIRE(q.receive(0).value()[0] == '1');
+        REQUIRE(q.receive(0).value()[0] == '2');
+        REQUIRE(q.receive(0).value()[0] == '\0');
+    }
+
+    SECTION("Producers are not blocked while an element is filled or peeked")
+    {
+        auto reserved{q.reserve()};
+        REQUIRE(q.try_send(frame{}));
+        reserved.commit();
+
+        auto m{q.peek()};
+        REQUIRE(q.try_send(frame{}));
+        m.release();
+
+        REQUIRE(q.receive(0).has_value());
+        REQUIRE(q.receive(0).has_value());
+        REQUIRE_FALSE(q.receive(0).has_value());
+    }
+
+    SECTION("Dropped reservation frees its slot and is skipped by the receivers")
+    {
+        {
+            auto dropped{q.reserve()};
+            q.send(frame{});
+        }
+        for (int i{0}; i < 3; ++i)
+            q.send(frame{});
+        REQUIRE_FALSE(q.try_send(frame{}));
+
+        for (int i{0}; i < 4; ++i)
+            REQUIRE(q.receive(0).has_value());
+        REQUIRE_FALSE(q.receive(0).has_value());
+    }
+
+    SECTION("Reserving an element in a full queue throws")
+    {
+        for (int i{0}; i < 4; ++i)
+            q.reserve().commit();
+        REQUIRE_THROWS(q.reserve());
+    }
+}
+
+TEST_CASE("Producers wait for free space instead of throwing", "[queue]")
+{
+    auto q{get_queue_object_for_test_run<std::string, 2>()};
+    q.send("1");
+    q.send("2");
+
+    SECTION("Element is not sent to a full queue and is left untouched")
+    {
+        std::string elem{"3"};
+        REQUIRE_FALSE(q.try_send(std::move(elem)));
+        REQUIRE_FALSE(q.send(std::move(elem), 10));
+        REQUIRE(elem == "3");
+    }
+
+    SECTION("Element is sent when space is freed before the timeout")
+    {
+        auto t{get_thread_for_test_run()};
+        t.start([&] {
+            utils::delay(std::chrono::milliseconds{10});
+            q.receive();
+        });
+
+        REQUIRE(q.send("3", 10000));
+        t.join();
+
+        REQUIRE(q.receive(0).value() == "2");
+        REQUIRE(q.receive(0).value() == "3");
+    }
+
+    SECTION("Element is sent without waiting when there is space")
+    {
+        q.receive();
+        REQUIRE(q.try_send("3"));
+        q.receive();
+        REQUIRE(q.send("4", 0));
+    }
+}
+
+TEST_CASE("Elements are received from ISR", "[queue]")
+{
+    // There are no interrupts on the POSIX port, so the ISR is played by the test task.
+    auto q{get_queue_object_for_test_run<std::string, 4>()};
+
+    SECTION("Nothing is received from an empty queue")
+    {
+        REQUIRE_FALSE(q.receive_from_isr().has_value());
+
+        std::vector<std::string> received;
+        REQUIRE(q.receive_batch_from_isr<4>(std::back_inserter(received)) == 0);
+        REQUIRE(received.empty());
+    }
+
+    SECTION("Elements are received one by one")
+    {
+        q.send("1");
+        q.send("2");
+        REQUIRE(q.receive_from_isr().value() == "1");
+        REQUIRE(q.receive_from_isr().value() == "2");
+        REQUIRE_FALSE(q.receive_from_isr().has_value());
+    }
+
+    SECTION("Batch is bounded and leaves the rest to the next receiver")
+    {
+        q.send("1");
+        q.send("2");
+        q.send("3");
+
+        std::vector<std::string> received;
+        REQUIRE(q.receive_batch_from_isr<2>(std::back_inserter(received)) == 2);
+        REQUIRE(received == std::vector<std::string>{"1", "2"});
+        REQUIRE(q.receive(0).value() == "3");
+        REQUIRE_FALSE(q.receive(0).has_value());
+    }
+
+    SECTION("Producer waiting for free space is woken up")
+    {
+        for (auto s : {"1", "2", "3", "4"})
+            q.send(s);
+
+        auto is_sent{false};
+        auto t{get_thread_for_test_run()};
+        t.start([&] { is_sent = q.send("5", 10000); });
+        utils::delay(std::chrono::milliseconds{10});
+
+        std::vector<std::string> received;
+        REQUIRE(q.receive_batch_from_isr<2>(std::back_inserter(received)) == 2);
+        t.join();
+
+        REQUIRE(is_sent);
+        REQUIRE(q.receive(0).value() == "3");
+        REQUIRE(q.receive(0).value() == "4");
+        REQUIRE(q.receive(0).value() == "5");
+    }
+}
@@ -6,6 +6,7 @@
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
 #include <chrono>
+#include <functional>
 #include <string>
 #include <thread>
 
@@ -154,3 +155,30 @@ TEST_CASE("Thread pool executes tasks", "[ThreadPool]") // NOLINT
         REQUIRE_THAT(duration_ms, Catch::Matchers::WithinAbs(53, 4));
     }
 }
+
+template<typename ThreadPool>
+static void execute_ignoring_full_queue(ThreadPool& pool, std::function<void(void)> task)
+{
+    try
+    {
+        pool.execute(std::move(task));
+    } catch (...)
+    {
+    }
+}
+
+TEST_CASE("Thread pool is destroyed", "[ThreadPool]") // NOLINT
+{
+    SECTION("Task executing another task doesn't block the destruction, when the queues are full")
+    {
+        auto pool{test::make_thread_pool<os::generic::RunnersCount{2}>()};
+
+        // The first runner sleeps, while its queue fills up, and then executes a task, while the pool is destroyed.
+        execute_ignoring_full_queue(pool, [&pool]() {
+            utils::delay(std::chrono::milliseconds{50});
+            execute_ignoring_full_queue(pool, []() {});
+        });
+        for (unsigned i = 0; i < 64; ++i)
+            execute_ignoring_full_queue(pool, []() {});
+    }
+}
@@ -0,0 +1,23 @@
+/**
+ * @file	byte_buffers_under_test_definition.hpp
+ * @brief	Defines the stream and message buffers to be injected to the generic tests.
+ */
+#ifndef BYTE_BUFFERS_UNDER_TEST_DEFINITION_HPP
+#define BYTE_BUFFERS_UNDER_TEST_DEFINITION_HPP
+
+#include "jungles_os_helpers/native/message_buffer.hpp"
+#include "jungles_os_helpers/native/stream_buffer.hpp"
+
+template<std::size_t Capacity>
+inline auto get_stream_buffer_for_test_run(std::size_t trigger_level = 1)
+{
+    return jungles::native::stream_buffer<Capacity>{trigger_level};
+}
+
+template<std::size_t Capacity>
+inline auto get_message_buffer_for_test_run()
+{
+    return jungles::native::message_buffer<Capacity>{};
+}
+
+#endif /* BYTE_BUFFERS_UNDER_TEST_DEFINITION_HPP */
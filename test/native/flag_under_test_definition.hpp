@@ -10,3 +10,8 @@ inline jungles::flag get_flag_implementation_under_test()
 {
     return jungles::flag{};
 }
+
+inline jungles::auto_reset_flag get_auto_reset_flag_implementation_under_test()
+{
+    return jungles::auto_reset_flag{};
+}
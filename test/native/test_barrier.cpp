@@ -0,0 +1,53 @@
+/**
+ * @file        test_barrier.cpp
+ * @brief       Native barrier tests.
+ */
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "../event_enum.hpp"
+#include "jungles_os_helpers/native/barrier.hpp"
+
+using namespace jungles::native;
+using namespace test_helpers;
+
+TEST_CASE("Native barrier synchronizes the participants", "[barrier][NativeBarrier]")
+{
+    barrier<Event::e1, Event::e2, Event::e3> b;
+
+    SECTION("Times out when not all the participants arrive")
+    {
+        REQUIRE_FALSE(b.arrive_and_wait<Event::e1>(std::chrono::milliseconds{10}));
+    }
+
+    SECTION("No participant passes before all of them arrive, in each cycle")
+    {
+        constexpr unsigned cycles{1000};
+        std::atomic<unsigned> arrivals{0};
+        std::atomic<bool> is_passed_prematurely{false};
+
+        auto participant{[&]<auto Participant>() {
+            for (unsigned i{0}; i < cycles; ++i)
+            {
+                arrivals++;
+                b.template arrive_and_wait<Participant>();
+                if (arrivals.load() < (i + 1) * 3)
+                    is_passed_prematurely = true;
+                b.template arrive_and_wait<Participant>();
+            }
+        }};
+
+        std::thread t1{[&]() { participant.template operator()<Event::e1>(); }};
+        std::thread t2{[&]() { participant.template operator()<Event::e2>(); }};
+        participant.template operator()<Event::e3>();
+
+        t1.join();
+        t2.join();
+
+        REQUIRE(arrivals == cycles * 3);
+        REQUIRE_FALSE(is_passed_prematurely);
+    }
+}
@@ -0,0 +1,116 @@
+/**
+ * @file        test_event_group.cpp
+ * @brief       Native event group tests.
+ */
+#include "catch2/catch_test_macros.hpp"
+
+#include <chrono>
+#include <thread>
+
+#include "../event_enum.hpp"
+#include "jungles_os_helpers/native/event_group.hpp"
+
+#include "platform_utils.hpp"
+
+using namespace jungles::native;
+using namespace test_helpers;
+
+using EventGroup64 = event_group<Event::e1, Event::e2, Event::e23, Event::e33, Event::e40, Event::e64>;
+
+TEST_CASE("Native event groups are set and cleared", "[EventGroup][NativeEventGroup]")
+{
+    EventGroup64 eg;
+
+    SECTION("Zero by default")
+    {
+        REQUIRE(eg.get() == 0);
+    }
+
+    SECTION("Sets the bits above the 32nd one")
+    {
+        eg.set<Event::e1, Event::e33, Event::e64>();
+        REQUIRE(eg.get() == 0x8000000100000001);
+
+        eg.clear<Event::e33>();
+        REQUIRE(eg.get() == 0x8000000000000001);
+    }
+}
+
+TEST_CASE("Native event groups are awaited", "[EventGroup][NativeEventGroup]")
+{
+    EventGroup64 eg;
+
+    SECTION("Waits for one event, which is then cleared")
+    {
+        std::thread setter{[&]() {
+            utils::delay(std::chrono::milliseconds{10});
+            eg.set<Event::e64>();
+        }};
+
+        REQUIRE(eg.wait_one<Event::e2, Event::e64>() == Event::e64);
+        REQUIRE(eg.get() == 0);
+
+        setter.join();
+    }
+
+    SECTION("Gets each event one by one")
+    {
+        eg.set<Event::e2, Event::e33, Event::e40>();
+
+        REQUIRE(eg.wait_one<Event::e2, Event::e33, Event::e40>() == Event::e2);
+        REQUIRE(eg.wait_one<Event::e2, Event::e33, Event::e40>() == Event::e33);
+        REQUIRE(eg.wait_one<Event::e2, Event::e33, Event::e40>() == Event::e40);
+    }
+
+    SECTION("Times out when only the other events are set")
+    {
+        eg.set<Event::e1, Event::e23>();
+        REQUIRE_FALSE(eg.wait_one<Event::e2, Event::e64>(std::chrono::milliseconds{10}).has_value());
+        REQUIRE(eg.get() == 0x400001);
+    }
+
+    SECTION("Waits for all the events")
+    {
+        eg.set<Event::e2>();
+        REQUIRE_FALSE(eg.wait_all<Event::e2, Event::e40>(std::chrono::milliseconds{10}));
+        REQUIRE(eg.get() == 0b10);
+
+        std::thread setter{[&]() {
+            utils::delay(std::chrono::milliseconds{10});
+            eg.set<Event::e40, Event::e1>();
+        }};
+
+        eg.wait_all<Event::e2, Event::e40>();
+        REQUIRE(eg.get() == 0b1);
+
+        setter.join();
+    }
+
+    SECTION("Each event is received by a single waiter")
+    {
+        Event received1, received2;
+        std::thread t1{[&]() { received1 = eg.wait_one<Event::e1, Event::e2>(); }};
+        std::thread t2{[&]() { received2 = eg.wait_one<Event::e1, Event::e2>(); }};
+
+        eg.set<Event::e1>();
+        eg.set<Event::e2>();
+        t1.join();
+        t2.join();
+
+        REQUIRE(received1 != received2);
+        REQUIRE(eg.get() == 0);
+    }
+
+    SECTION("Waits for any of the events and receives all the set ones at once")
+    {
+        eg.set<Event::e1, Event::e33, Event::e64>();
+
+        auto events{eg.wait_any<Event::e2, Event::e33, Event::e64>()};
+        REQUIRE(events.size() == 2);
+        REQUIRE(events.contains(Event::e33));
+        REQUIRE(events.contains(Event::e64));
+        REQUIRE(eg.get() == 0b1);
+
+        REQUIRE(eg.wait_any<Event::e2, Event::e33, Event::e64>(std::chrono::milliseconds{10}).empty());
+    }
+}
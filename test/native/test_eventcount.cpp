@@ -0,0 +1,67 @@
+/**
+ * @file	test_eventcount.cpp
+ * @brief	Tests the eventcount used by the native primitives.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "jungles_os_helpers/native/eventcount.hpp"
+
+using namespace jungles::native;
+
+TEST_CASE("Eventcount wakes up threads waiting for a condition", "[eventcount]")
+{
+    eventcount ec;
+    std::atomic<bool> condition{false};
+    auto is_ready{[&]() {
+        return condition.load();
+    }};
+
+    SECTION("Notifying without waiters does nothing")
+    {
+        ec.notify_one();
+        ec.notify_all();
+        REQUIRE_FALSE(ec.wait_until(is_ready, std::chrono::steady_clock::now()));
+    }
+
+    SECTION("Doesn't block when the condition is already fulfilled")
+    {
+        condition = true;
+        ec.wait(is_ready);
+        REQUIRE(ec.wait_until(is_ready, std::chrono::steady_clock::now()));
+    }
+
+    SECTION("Wakes up all the waiters")
+    {
+        std::atomic<unsigned> num_woken_up{0};
+        std::vector<std::thread> waiters;
+        for (unsigned i{0}; i < 4; ++i)
+            waiters.emplace_back([&]() {
+                ec.wait(is_ready);
+                ++num_woken_up;
+            });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        condition = true;
+        ec.notify_all();
+
+        for (auto& t : waiters)
+            t.join();
+        REQUIRE(num_woken_up == 4);
+    }
+
+    SECTION("Times out when not notified")
+    {
+        auto begin{std::chrono::steady_clock::now()};
+        auto is_fulfilled{ec.wait_until(is_ready, begin + std::chrono::milliseconds{20})};
+        auto end{std::chrono::steady_clock::now()};
+
+        REQUIRE_FALSE(is_fulfilled);
+        REQUIRE(end - begin >= std::chrono::milliseconds{20});
+    }
+}
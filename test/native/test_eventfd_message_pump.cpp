@@ -0,0 +1,100 @@
+/**
+ * @file	test_eventfd_message_pump.cpp
+ * @brief	Tests the message pump which is waited on through an eventfd.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include "jungles_os_helpers/native/eventfd_message_pump.hpp"
+
+using namespace jungles::native;
+
+namespace
+{
+
+struct epoll_loop
+{
+    int epfd{epoll_create1(EPOLL_CLOEXEC)};
+
+    ~epoll_loop()
+    {
+        close(epfd);
+    }
+
+    void add(int fd)
+    {
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev);
+    }
+
+    //! @return Number of ready descriptors.
+    int wait(int timeout_ms)
+    {
+        epoll_event events[4];
+        return epoll_wait(epfd, events, 4, timeout_ms);
+    }
+};
+
+} // namespace
+
+TEST_CASE("Eventfd message pump is waited on by an event loop", "[eventfd_message_pump]")
+{
+    eventfd_message_pump<std::string> pump;
+    epoll_loop loop;
+    loop.add(pump.native_handle());
+
+    SECTION("Empty pump is not readable")
+    {
+        REQUIRE(loop.wait(0) == 0);
+    }
+
+    SECTION("Pump with messages is readable until it is drained")
+    {
+        pump.send("1");
+        pump.send("2");
+        pump.send("3");
+        REQUIRE(loop.wait(0) == 1);
+
+        std::vector<std::string> received;
+        REQUIRE(pump.receive_many_immediate(std::back_inserter(received), 2) == 2);
+        REQUIRE(loop.wait(0) == 1);
+
+        REQUIRE(pump.receive_many_immediate(std::back_inserter(received), 2) == 1);
+        REQUIRE(loop.wait(0) == 0);
+        REQUIRE(received == std::vector<std::string>{"1", "2", "3"});
+    }
+
+    SECTION("Batch makes the pump readable once")
+    {
+        std::vector<std::string> batch{"1", "2"};
+        pump.send_many(batch);
+        REQUIRE(loop.wait(0) == 1);
+
+        REQUIRE(pump.receive_immediate().value() == "1");
+        REQUIRE(pump.receive_immediate().value() == "2");
+        REQUIRE(loop.wait(0) == 0);
+    }
+
+    SECTION("Event loop is woken up by a message sent from another thread")
+    {
+        std::thread t{[&]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+            pump.send("1");
+        }};
+
+        REQUIRE(loop.wait(1000) == 1);
+        REQUIRE(pump.receive() == "1");
+
+        t.join();
+    }
+}
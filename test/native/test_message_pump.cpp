@@ -0,0 +1,224 @@
+/**
+ * @file	test_message_pump.cpp
+ * @brief	Tests the native message pump with different waiting strategies.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+
+#include <array>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "jungles_os_helpers/native/flag.hpp"
+#include "jungles_os_helpers/native/message_pump.hpp"
+
+using namespace jungles::native;
+
+TEST_CASE("Message pump passes messages between threads", "[message_pump]")
+{
+    SECTION("Parking message pump")
+    {
+        message_pump<std::string, wait_strategy::park> pump;
+
+        std::thread t{[&]() {
+            pump.send("1");
+            pump.send("2");
+        }};
+
+        REQUIRE(pump.receive() == "1");
+        REQUIRE(pump.receive() == "2");
+        REQUIRE_FALSE(pump.receive_immediate().has_value());
+
+        t.join();
+    }
+
+    SECTION("Low-latency message pump")
+    {
+        message_pump<std::string, wait_strategy::low_latency> pump;
+
+        std::thread t{[&]() {
+            pump.send("1");
+            pump.send("2");
+        }};
+
+        REQUIRE(pump.receive() == "1");
+        REQUIRE(pump.receive() == "2");
+        REQUIRE_FALSE(pump.receive_immediate().has_value());
+
+        t.join();
+    }
+
+    SECTION("Message pump which exhausts spinning parks until a message comes")
+    {
+        message_pump<std::string, wait_strategy::spin_then_park<1, 1>> pump;
+        jungles::flag receiver_started;
+
+        std::thread t{[&]() {
+            receiver_started.wait();
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+            pump.send("1");
+        }};
+
+        receiver_started.set();
+        REQUIRE(pump.receive() == "1");
+
+        t.join();
+    }
+}
+
+TEST_CASE("Message pump passes messages in batches", "[message_pump]")
+{
+    message_pump<std::string> pump;
+
+    SECTION("Whole batch is received at once")
+    {
+        std::vector<std::string> batch{"1", "2", "3"};
+        pump.send_many(batch);
+
+        std::vector<std::string> received;
+        REQUIRE(pump.receive_many(std::back_inserter(received), 8) == 3);
+        REQUIRE(received == std::vector<std::string>{"1", "2", "3"});
+    }
+
+    SECTION("No more messages than requested are received")
+    {
+        std::vector<std::string> batch{"1", "2", "3"};
+        pump.send_many(batch);
+
+        std::vector<std::string> received;
+        REQUIRE(pump.receive_many(std::back_inserter(received), 2) == 2);
+        REQUIRE(received == std::vector<std::string>{"1", "2"});
+        REQUIRE(pump.receive_immediate().value() == "3");
+    }
+
+    SECTION("Batch receive blocks until a batch is sent from another thread")
+    {
+        std::thread t{[&]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+            std::vector<std::string> batch{"1", "2"};
+            pump.send_many(batch);
+        }};
+
+        std::vector<std::string> received;
+        while (received.size() < 2)
+            pump.receive_many(std::back_inserter(received), 8);
+        REQUIRE(received == std::vector<std::string>{"1", "2"});
+
+        t.join();
+    }
+}
+
+TEST_CASE("Messages are filled and read in place", "[message_pump]")
+{
+    using frame = std::array<char, 4096>;
+    message_pump<frame> pump;
+
+    SECTION("Reserved message is received after it is committed")
+    {
+        auto f{pump.reserve()};
+        f->fill('a');
+        REQUIRE(pump.is_empty());
+        f.commit();
+
+        REQUIRE_FALSE(pump.is_empty());
+        REQUIRE(pump.receive()[4095] == 'a');
+    }
+
+    SECTION("Peeked message is removed on release")
+    {
+        auto b{pump.reserve()};
+        b->fill('b');
+        b.commit();
+        auto c{pump.reserve()};
+        c->fill('c');
+        c.commit();
+
+        {
+            auto m{pump.peek()};
+            REQUIRE((*m)[0] == 'b');
+        }
+        auto m{pump.peek()};
+        REQUIRE((*m)[0] == 'c');
+        m.release();
+        REQUIRE(pump.is_empty());
+    }
+
+    SECTION("Consumer peeks a message reserved by another thread")
+    {
+        std::thread t{[&]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+            auto f{pump.reserve()};
+            f->fill('d');
+            f.commit();
+        }};
+
+        REQUIRE((*pump.peek())[100] == 'd');
+        REQUIRE(pump.is_empty());
+
+        t.join();
+    }
+
+    SECTION("Messages are published in the order of their reservations")
+    {
+        auto first{pump.reserve()};
+        auto second{pump.reserve()};
+        second->fill('2');
+        second.commit();
+        pump.send(frame{});
+        REQUIRE(pump.is_empty());
+
+        first->fill('1');
+        first.commit();
+        REQUIRE(pump.receive()[0] == '1');
+        REQUIRE(pump.receive()[0] == '2');
+        REQUIRE(pump.receive()[0] == '\0');
+    }
+
+    SECTION("Producers and receivers are not blocked while a message is filled or peeked")
+    {
+        auto reserved{pump.reserve()};
+        std::thread t{[&]() { pump.send(frame{}); }};
+        t.join();
+
+        auto peeked_message_is_sent{false};
+        {
+            reserved.commit();
+            auto m{pump.peek()};
+            std::thread t2{[&]() {
+                pump.send(frame{});
+                peeked_message_is_sent = true;
+            }};
+            t2.join();
+        }
+        REQUIRE(peeked_message_is_sent);
+        REQUIRE(pump.receive_immediate().has_value());
+        REQUIRE(pump.receive_immediate().has_value());
+        REQUIRE(pump.is_empty());
+    }
+
+    SECTION("Dropped reservation is skipped by the receivers")
+    {
+        {
+            auto dropped{pump.reserve()};
+            pump.send(frame{});
+            REQUIRE(pump.is_empty());
+        }
+        REQUIRE_FALSE(pump.is_empty());
+        REQUIRE(pump.receive_immediate().has_value());
+        REQUIRE_FALSE(pump.receive_immediate().has_value());
+    }
+}
+
+TEST_CASE("Low-latency flag is waited for", "[flag]")
+{
+    jungles::basic_flag<wait_strategy::low_latency> flag;
+
+    std::thread t{[&]() { flag.set(); }};
+
+    REQUIRE(flag.wait_for(std::chrono::seconds{1}));
+    REQUIRE(flag.is_set());
+
+    t.join();
+}
@@ -0,0 +1,104 @@
+/**
+ * @file	test_pump_selector.cpp
+ * @brief	Tests waiting on multiple native message pumps at once.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "jungles_os_helpers/native/message_pump.hpp"
+#include "jungles_os_helpers/native/pump_selector.hpp"
+
+using namespace jungles::native;
+using jungles::generic::select_order;
+
+TEST_CASE("Selector tells which message pump is ready", "[pump_selector]")
+{
+    message_pump<std::string> strings;
+    message_pump<int> ints;
+
+    SECTION("Times out when no pump is ready")
+    {
+        pump_selector selector{strings, ints};
+        REQUIRE_FALSE(selector.wait_for(std::chrono::milliseconds{10}).has_value());
+    }
+
+    SECTION("Returns the pump which has a message")
+    {
+        pump_selector selector{strings, ints};
+        ints.send(5);
+
+        REQUIRE(selector.wait() == 1);
+        REQUIRE(ints.receive_immediate().value() == 5);
+    }
+
+    SECTION("Wakes up when a message is sent from another thread")
+    {
+        pump_selector selector{strings, ints};
+
+        std::thread t{[&]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+            strings.send("1");
+        }};
+
+        REQUIRE(selector.wait_for(std::chrono::seconds{1}) == 0);
+        REQUIRE(strings.receive_immediate().value() == "1");
+
+        t.join();
+    }
+
+    SECTION("Serves the pumps by priority")
+    {
+        pump_selector selector{select_order::priority, strings, ints};
+        strings.send("1");
+        strings.send("2");
+        ints.send(1);
+
+        REQUIRE(selector.wait() == 0);
+        strings.receive_immediate();
+        REQUIRE(selector.wait() == 0);
+        strings.receive_immediate();
+        REQUIRE(selector.wait() == 1);
+    }
+
+    SECTION("Serves the pumps in round-robin fashion")
+    {
+        pump_selector selector{select_order::round_robin, strings, ints};
+        strings.send("1");
+        strings.send("2");
+        ints.send(1);
+
+        REQUIRE(selector.wait() == 0);
+        strings.receive_immediate();
+        REQUIRE(selector.wait() == 1);
+        ints.receive_immediate();
+        REQUIRE(selector.wait() == 0);
+    }
+
+    SECTION("Selector is destroyed while a producer keeps sending")
+    {
+        std::atomic<bool> is_done{false};
+        std::thread producer{[&]() {
+            while (!is_done)
+            {
+                ints.send(1);
+                ints.receive_immediate();
+            }
+        }};
+
+        // Allocated on the heap, so that a notification of a destroyed selector is caught by the sanitizers.
+        for (unsigned i{0}; i < 1000; ++i)
+        {
+            auto selector{std::make_unique<pump_selector<message_pump<std::string>, message_pump<int>>>(strings, ints)};
+            selector->wait_for(std::chrono::milliseconds{1});
+        }
+
+        is_done = true;
+        producer.join();
+    }
+}
@@ -0,0 +1,179 @@
+/**
+ * @file	test_shm_message_pump.cpp
+ * @brief	Tests the message pump shared between processes.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "jungles_os_helpers/generic/active.hpp"
+#include "jungles_os_helpers/native/shm_message_pump.hpp"
+#include "jungles_os_helpers/native/thread.hpp"
+
+using namespace jungles::native;
+
+struct frame
+{
+    unsigned id;
+    char payload[16];
+};
+
+TEST_CASE("Shared memory message pump passes messages", "[shm_message_pump]")
+{
+    SECTION("Messages sent through one mapping are received through another one")
+    {
+        const char* name{"/jungles_test_shm_message_pump"};
+        shm_message_pump<frame, 4> producer{name};
+        shm_message_pump<frame, 4> consumer{name};
+        shm_message_pump<frame, 4>::remove(name);
+
+        producer.send(frame{1, "first"});
+        producer.send(frame{2, "second"});
+
+        auto f1{consumer.receive()};
+        auto f2{consumer.receive()};
+        REQUIRE(f1.id == 1);
+        REQUIRE(std::string{f1.payload} == "first");
+        REQUIRE(f2.id == 2);
+        REQUIRE(std::string{f2.payload} == "second");
+        REQUIRE_FALSE(consumer.receive_immediate().has_value());
+    }
+
+    SECTION("Full ring rejects a message on try_send and blocks send until there is space")
+    {
+        shm_message_pump<unsigned, 2> pump;
+        shm_message_pump<unsigned, 2> other_end{pump.native_handle()};
+
+        REQUIRE(pump.try_send(1));
+        REQUIRE(pump.try_send(2));
+        REQUIRE_FALSE(pump.try_send(3));
+
+        std::thread t{[&]() { pump.send(3); }};
+
+        REQUIRE(other_end.receive() == 1);
+        REQUIRE(other_end.receive() == 2);
+        REQUIRE(other_end.receive() == 3);
+
+        t.join();
+    }
+
+    SECTION("Messages are constructed and read in place")
+    {
+        shm_message_pump<frame, 4> pump;
+        shm_message_pump<frame, 4> other_end{pump.native_handle()};
+
+        auto first{pump.reserve()};
+        auto second{pump.reserve()};
+        second->id = 2;
+        std::strcpy(second->payload, "second");
+        second.commit();
+        REQUIRE_FALSE(other_end.try_peek().has_value());
+
+        first->id = 1;
+        std::strcpy(first->payload, "first");
+        first.commit();
+
+        {
+            auto m{other_end.peek()};
+            REQUIRE(m->id == 1);
+            REQUIRE(std::string{m->payload} == "first");
+        }
+        auto m{other_end.peek()};
+        REQUIRE(m->id == 2);
+        REQUIRE(std::string{m->payload} == "second");
+        m.release();
+        REQUIRE(other_end.is_empty());
+    }
+
+    SECTION("Dropped reservation is skipped by the receivers and frees its slot")
+    {
+        shm_message_pump<unsigned, 4> pump;
+
+        {
+            auto dropped{pump.reserve(1u)};
+            pump.send(2);
+        }
+        pump.send(3);
+
+        REQUIRE(pump.receive() == 2);
+        REQUIRE(pump.receive() == 3);
+        REQUIRE_FALSE(pump.receive_immediate().has_value());
+    }
+
+    SECTION("Messages are passed between processes")
+    {
+        shm_message_pump<unsigned> pump;
+
+        auto pid{fork()};
+        REQUIRE(pid != -1);
+        if (pid == 0)
+        {
+            shm_message_pump<unsigned> child_end{pump.native_handle()};
+            for (unsigned i{0}; i < 1000; ++i)
+                child_end.send(unsigned{i});
+            _exit(0);
+        }
+
+        unsigned sum{0};
+        for (unsigned i{0}; i < 1000; ++i)
+            sum += pump.receive();
+
+        int status;
+        waitpid(pid, &status, 0);
+        REQUIRE(sum == 499500);
+    }
+
+    SECTION("Attaching to a segment which is never initialized times out")
+    {
+        auto attach_error{[](int fd) {
+            try
+            {
+                shm_message_pump<unsigned> pump{fd, std::chrono::milliseconds{10}};
+            } catch (const std::system_error& e)
+            {
+                return e.code().value();
+            }
+            return 0;
+        }};
+
+        // As if the creator died before resizing the segment, and after it, but before initializing it.
+        auto fd{memfd_create("never_initialized", MFD_CLOEXEC)};
+        REQUIRE(fd != -1);
+        REQUIRE(attach_error(fd) == ETIMEDOUT);
+        REQUIRE(ftruncate(fd, 1024 * 1024) == 0);
+        REQUIRE(attach_error(fd) == ETIMEDOUT);
+        close(fd);
+    }
+}
+
+template<typename T>
+using ShmMessagePump = shm_message_pump<T, 16>;
+
+TEST_CASE("Shared memory message pump plugs into an active", "[shm_message_pump][active]")
+{
+    using Active = jungles::generic::active<unsigned, ShmMessagePump, jungles::native::thread>;
+
+    std::atomic<unsigned> sum{0};
+    {
+        Active::MessagePump pump;
+        jungles::native::thread thread;
+        Active active{[&](unsigned&& v) { sum += v; }, pump, thread};
+
+        Active::MessagePump producer_end{pump.native_handle()};
+        producer_end.send(Active::MessageProxy{1u});
+        active.send(2);
+    }
+
+    REQUIRE(sum == 3);
+}
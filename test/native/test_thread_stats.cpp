@@ -0,0 +1,73 @@
+/**
+ * @file	test_thread_stats.cpp
+ * @brief	Tests the statistics of the native thread.
+ * @author	Kacper Kowalski - kacper.s.kowalski@gmail.com
+ */
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "jungles_os_helpers/native/thread.hpp"
+#include "jungles_os_helpers/native/thread_pool.hpp"
+
+using namespace jungles::native;
+
+TEST_CASE("Native thread reports its statistics", "[thread_stats]")
+{
+    thread t;
+
+    SECTION("Thread which is not started has no statistics")
+    {
+        auto s{t.stats()};
+        REQUIRE(s.state == '\0');
+        REQUIRE(s.runtime.count() == 0);
+    }
+
+    SECTION("Busy thread consumes CPU time")
+    {
+        std::atomic<bool> done{false};
+        t.start([&]() {
+            while (!done)
+                ;
+        });
+
+        t.stats();
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        auto s{t.stats()};
+        done = true;
+        t.join();
+
+        REQUIRE(s.state == 'R');
+        REQUIRE(s.runtime > std::chrono::milliseconds{10});
+        REQUIRE(s.cpu_share_permille > 100);
+    }
+
+    SECTION("Sleeping thread consumes almost no CPU time")
+    {
+        t.start([]() { std::this_thread::sleep_for(std::chrono::milliseconds{100}); });
+
+        t.stats();
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        auto s{t.stats()};
+        t.join();
+
+        REQUIRE(s.state == 'S');
+        REQUIRE(s.cpu_share_permille < 100);
+    }
+
+    SECTION("Joined thread has no statistics")
+    {
+        t.start([]() {});
+        t.join();
+        REQUIRE(t.stats().state == '\0');
+    }
+}
+
+TEST_CASE("Thread pool runners report their statistics", "[thread_stats][thread_pool]")
+{
+    os::native::thread_pool<2> pool;
+    REQUIRE(pool.runner(0).stats().state != '\0');
+    REQUIRE(pool.runner(1).stats().state != '\0');
+}